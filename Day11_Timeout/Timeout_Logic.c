@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "../FSM_Generator/Fsm_Print.h"
 
 // Configuration
 #define TIMEOUT_MS      1000  // 1 second timeout
@@ -38,7 +39,7 @@ void Comm_Update(CommSystem *sys) {
             break;
 
         case STATE_SEND_CMD:
-            printf("[Command Sent] -> Waiting for reply...\n");
+            Fsm_Printf("[Command Sent] -> Waiting for reply...\n");
             // TODO: Reset timer to 0
             // TODO: Move to STATE_WAIT_RESP
             sys->timer_ticks = 0;
@@ -64,16 +65,45 @@ void Comm_Update(CommSystem *sys) {
             break;
 
         case STATE_CHARGING:
-            printf("[Charging] All systems go.\n");
+            Fsm_Printf("[Charging] All systems go.\n");
             break;
 
         case STATE_ERROR:
-            printf("[Error] Timeout! Charger did not reply.\n");
+            Fsm_Printf("[Error] Timeout! Charger did not reply.\n");
             // Stuck here
             break;
     }
 }
 
+// Generated version (FSM_Generator/Fsm_Gen.h)
+// Comm_Update() written as a declarative description. The timer reset becomes
+// the entry action of WAIT_RESP, and the two polled checks are guarded rows in
+// priority order (the reply wins over the timeout). CHARGING and ERROR are
+// dead ends on purpose, so they are marked FSM_TERMINAL.
+// FSM_COUNT_TRANSITIONS turns on the generated per-edge transition counters.
+typedef struct {
+    uint32_t timer_ticks;
+} Comm_Ctx;
+
+#define FSM_COUNT_TRANSITIONS
+#define FSM_NAME     Comm
+#define FSM_CTX      Comm_Ctx
+#define FSM_INITIAL  COMM_IDLE
+#define FSM_DISPATCH FSM_DISPATCH_SWITCH
+#define FSM_STATES(S) \
+    S(COMM_IDLE,      FSM_NORMAL,   FSM_NONE,               FSM_NONE,                                                FSM_NONE) \
+    S(COMM_SEND_CMD,  FSM_NORMAL,   FSM_NONE,               Fsm_Printf("[Command Sent] -> Waiting for reply...\n"),  FSM_NONE) \
+    S(COMM_WAIT_RESP, FSM_NORMAL,   ctx->timer_ticks = 0,   ctx->timer_ticks++,                                      FSM_NONE) \
+    S(COMM_CHARGING,  FSM_TERMINAL, FSM_NONE,               Fsm_Printf("[Charging] All systems go.\n"),              FSM_NONE) \
+    S(COMM_ERROR,     FSM_TERMINAL, FSM_NONE,               Fsm_Printf("[Error] Timeout! Charger did not reply.\n"), FSM_NONE)
+#define FSM_EVENTS(E) E(COMM_EV_TICK)
+#define FSM_TRANSITIONS(T) \
+    T(COMM_IDLE,      COMM_EV_TICK, FSM_ALWAYS,                   FSM_NONE, COMM_SEND_CMD) \
+    T(COMM_SEND_CMD,  COMM_EV_TICK, FSM_ALWAYS,                   FSM_NONE, COMM_WAIT_RESP) \
+    T(COMM_WAIT_RESP, COMM_EV_TICK, IsResponseReceived(),         FSM_NONE, COMM_CHARGING) \
+    T(COMM_WAIT_RESP, COMM_EV_TICK, ctx->timer_ticks > MAX_TICKS, FSM_NONE, COMM_ERROR)
+#include "../FSM_Generator/Fsm_Gen.h"
+
 int main() {
     CommSystem sys = {0};
     sys.state = STATE_IDLE;
@@ -113,5 +143,43 @@ int main() {
         }
     }
 
-    return 0;
+    printf("\n--- Test 3: Generated FSM (Fsm_Gen.h) vs Comm_Update ---\n");
+    // Reply arrives after a random delay (sometimes too late); both versions in lock-step
+    uint32_t seed = 12345;
+    // Each side prints into its own log; the logs are compared after every run
+    int runs = 2000, mismatches = 0, output_mismatches = 0;
+    size_t output_lines = 0;
+    Fsm_Log hand_log = { 0 }, gen_log = { 0 };
+    for (int r = 0; r < runs; r++) {
+        seed = seed * 1664525u + 1013904223u;
+        int reply_tick = (int)((seed >> 8) % 150);
+        CommSystem hand = { STATE_IDLE, 0 };
+        Comm_Ctx ctx = { 0 };
+        Comm_Fsm gen;
+        Comm_Init(&gen, &ctx);
+        Fsm_Log_Clear(&hand_log);
+        Fsm_Log_Clear(&gen_log);
+        for (int i = 0; i < 130; i++) {
+            mock_response_flag = (i >= reply_tick);
+            fsm_print_log = &hand_log;
+            Comm_Update(&hand);
+            fsm_print_log = &gen_log;
+            Comm_Step(&gen, &ctx, COMM_EV_TICK);
+            if ((int)hand.state != (int)gen.state || hand.timer_ticks != ctx.timer_ticks) mismatches++;
+        }
+        fsm_print_log = NULL;
+        output_mismatches += hand_log.failed || gen_log.failed || !Fsm_Log_Equal(&hand_log, &gen_log);
+        output_lines += Fsm_Log_Lines(&hand_log);
+    }
+    Fsm_Log_Free(&hand_log);
+    Fsm_Log_Free(&gen_log);
+    printf("%d runs x 130 ticks: states and timer %s, output (%zu lines) %s\n", runs,
+           mismatches ? "MISMATCH!" : "IDENTICAL", output_lines, output_mismatches ? "MISMATCH!" : "IDENTICAL");
+    printf("Transition counts (FSM_COUNT_TRANSITIONS):\n");
+    for (int from = 0; from < Comm_STATE_COUNT; from++)
+        for (int to = 0; to < Comm_STATE_COUNT; to++)
+            if (Comm_transition_count[from][to])
+                printf("  %-14s -> %-14s %u\n", Comm_state_names[from], Comm_state_names[to], Comm_transition_count[from][to]);
+
+    return (mismatches == 0 && output_mismatches == 0) ? 0 : 1;
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include "../FSM_Generator/Fsm_Print.h"
 
 // 1. Define State Indices
 typedef enum {
@@ -36,7 +38,7 @@ const StateHandler State_Table[NUM_STATES] = {
 // --- State Implementations ---
 
 void Handler_Idle(void) {
-    printf("[IDLE] Waiting... (Count: %d)\n", system_counter);
+    Fsm_Printf("[IDLE] Waiting... (Count: %d)\n", system_counter);
     system_counter++;
     
     // TODO: If counter > 2, transition to ACTIVE
@@ -46,7 +48,7 @@ void Handler_Idle(void) {
 }
 
 void Handler_Active(void) {
-    printf("[ACTIVE] Doing heavy work...\n");
+    Fsm_Printf("[ACTIVE] Doing heavy work...\n");
     // TODO: Reset counter to 0
     system_counter = 0;
     // TODO: Transition to FAULT (Simulating a crash)
@@ -54,11 +56,43 @@ void Handler_Active(void) {
 }
 
 void Handler_Fault(void) {
-    printf("[FAULT] Clearing errors...\n");
+    Fsm_Printf("[FAULT] Clearing errors...\n");
     // TODO: Transition back to IDLE
     current_state = STATE_IDLE;
 }
 
+// --- Generated version (FSM_Generator/Fsm_Gen.h) ---
+// The same three handlers as a declarative description. FSM_DISPATCH_TABLE
+// makes App_Step() index a generated jump table of per-state functions, just
+// like State_Table[] above. The table, the enum and the switch alternative all
+// come from one list. Compile with -DFSM_DEMO_UNREACHABLE to see the
+// reachability check reject a state that no transition leads to.
+typedef struct {
+    uint32_t counter;
+} App_Ctx;
+
+#define FSM_COUNT_TRANSITIONS
+#define FSM_NAME     App
+#define FSM_CTX      App_Ctx
+#define FSM_INITIAL  APP_IDLE
+#define FSM_DISPATCH FSM_DISPATCH_TABLE
+#if defined(FSM_DEMO_UNREACHABLE)
+#define APP_DEMO_STATE(S) S(APP_SPARE, FSM_TERMINAL, FSM_NONE, FSM_NONE, FSM_NONE)
+#else
+#define APP_DEMO_STATE(S)
+#endif
+#define FSM_STATES(S) \
+    S(APP_IDLE,   FSM_NORMAL, FSM_NONE, (Fsm_Printf("[IDLE] Waiting... (Count: %d)\n", ctx->counter), ctx->counter++), FSM_NONE) \
+    S(APP_ACTIVE, FSM_NORMAL, FSM_NONE, (Fsm_Printf("[ACTIVE] Doing heavy work...\n"), ctx->counter = 0),              FSM_NONE) \
+    S(APP_FAULT,  FSM_NORMAL, FSM_NONE, Fsm_Printf("[FAULT] Clearing errors...\n"),                                    FSM_NONE) \
+    APP_DEMO_STATE(S)
+#define FSM_EVENTS(E) E(APP_EV_TICK)
+#define FSM_TRANSITIONS(T) \
+    T(APP_IDLE,   APP_EV_TICK, ctx->counter > 2, FSM_NONE, APP_ACTIVE) \
+    T(APP_ACTIVE, APP_EV_TICK, FSM_ALWAYS,       FSM_NONE, APP_FAULT) \
+    T(APP_FAULT,  APP_EV_TICK, FSM_ALWAYS,       FSM_NONE, APP_IDLE)
+#include "../FSM_Generator/Fsm_Gen.h"
+
 // --- Main Loop ---
 
 int main() {
@@ -77,5 +111,32 @@ int main() {
         }
     }
 
-    return 0;
+    printf("\n--- Generated FSM (Fsm_Gen.h, jump table) vs State_Table ---\n");
+    current_state = STATE_IDLE;
+    system_counter = 0;
+    App_Ctx ctx = { 0 };
+    App_Fsm app;
+    App_Init(&app, &ctx);
+    // Each side prints into its own log; the logs must match byte for byte
+    Fsm_Log hand_log = { 0 }, gen_log = { 0 };
+    int mismatches = 0;
+    for (int i = 0; i < 1000; i++) {
+        fsm_print_log = &hand_log;
+        State_Table[current_state]();
+        fsm_print_log = &gen_log;
+        App_Step(&app, &ctx, APP_EV_TICK);
+        if ((int)current_state != (int)app.state || system_counter != ctx.counter) mismatches++;
+    }
+    fsm_print_log = NULL;
+    bool same_output = !hand_log.failed && !gen_log.failed && Fsm_Log_Equal(&hand_log, &gen_log);
+    printf("1000 ticks in lock-step: states %s, output (%zu lines) %s\n", mismatches ? "MISMATCH!" : "IDENTICAL",
+           Fsm_Log_Lines(&hand_log), same_output ? "IDENTICAL" : "MISMATCH!");
+    Fsm_Log_Free(&hand_log);
+    Fsm_Log_Free(&gen_log);
+    for (int from = 0; from < App_STATE_COUNT; from++)
+        for (int to = 0; to < App_STATE_COUNT; to++)
+            if (App_transition_count[from][to])
+                printf("  %-10s -> %-10s %u\n", App_state_names[from], App_state_names[to], App_transition_count[from][to]);
+
+    return (mismatches == 0 && same_output) ? 0 : 1;
 }
\ No newline at end of file
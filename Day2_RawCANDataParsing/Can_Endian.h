@@ -0,0 +1,136 @@
+#ifndef CAN_ENDIAN_H
+#define CAN_ENDIAN_H
+
+// Endianness-Safe Load/Store Helpers (Header-Only)
+// Replacement for the union trick in Parse_Can_Union():
+//   - memcpy() into an integer is the only type-punning the C standard allows,
+//     and compilers turn a fixed-size memcpy into one plain load.
+//   - If the wire order differs from the host order, __builtin_bswapXX() swaps it.
+//     That is one BSWAP/MOVBE (x86) or REV (ARM) instruction.
+// The result is as fast as the union, but correct on both endiannesses.
+//
+// Big-Endian Emulation: compile with -DCAN_ENDIAN_EMULATE_BIG to make the
+// "native" load/store behave exactly like memcpy() on a big-endian CPU.
+// The same self-test then runs through the byte-swapping code paths.
+
+#include <stdint.h>
+#include <string.h>
+
+// --- Host byte order ---
+#if defined(CAN_ENDIAN_EMULATE_BIG)
+#define CAN_HOST_BIG_ENDIAN 1
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define CAN_HOST_BIG_ENDIAN 1
+#else
+#define CAN_HOST_BIG_ENDIAN 0
+#endif
+
+// --- Byte swap (builtins on GCC/Clang, shifts elsewhere) ---
+#if defined(__GNUC__) || defined(__clang__)
+#define CAN_BSWAP16(x) __builtin_bswap16(x)
+#define CAN_BSWAP32(x) __builtin_bswap32(x)
+#define CAN_BSWAP64(x) __builtin_bswap64(x)
+#else
+#define CAN_BSWAP16(x) ((uint16_t)(((x) >> 8) | ((x) << 8)))
+#define CAN_BSWAP32(x) ((((x) & 0xFF000000u) >> 24) | (((x) & 0x00FF0000u) >> 8) | \
+                        (((x) & 0x0000FF00u) << 8)  | (((x) & 0x000000FFu) << 24))
+#define CAN_BSWAP64(x) (((uint64_t)CAN_BSWAP32((uint32_t)(x)) << 32) | CAN_BSWAP32((uint32_t)((x) >> 32)))
+#endif
+
+// --- Native (host order) access ---
+#if defined(CAN_ENDIAN_EMULATE_BIG)
+// Emulated big-endian CPU: the byte at the lowest address is the MSB
+static inline uint64_t can_native_load(const void *p, int bytes) {
+    const uint8_t *b = (const uint8_t *)p;
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v = (v << 8) | b[i];
+    return v;
+}
+static inline void can_native_store(void *p, uint64_t v, int bytes) {
+    uint8_t *b = (uint8_t *)p;
+    for (int i = bytes - 1; i >= 0; i--) {
+        b[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+static inline uint16_t can_native16(const void *p) { return (uint16_t)can_native_load(p, 2); }
+static inline uint32_t can_native32(const void *p) { return (uint32_t)can_native_load(p, 4); }
+static inline uint64_t can_native64(const void *p) { return can_native_load(p, 8); }
+static inline void can_native_store16(void *p, uint16_t v) { can_native_store(p, v, 2); }
+static inline void can_native_store32(void *p, uint32_t v) { can_native_store(p, v, 4); }
+static inline void can_native_store64(void *p, uint64_t v) { can_native_store(p, v, 8); }
+#else
+static inline uint16_t can_native16(const void *p) { uint16_t v; memcpy(&v, p, 2); return v; }
+static inline uint32_t can_native32(const void *p) { uint32_t v; memcpy(&v, p, 4); return v; }
+static inline uint64_t can_native64(const void *p) { uint64_t v; memcpy(&v, p, 8); return v; }
+static inline void can_native_store16(void *p, uint16_t v) { memcpy(p, &v, 2); }
+static inline void can_native_store32(void *p, uint32_t v) { memcpy(p, &v, 4); }
+static inline void can_native_store64(void *p, uint64_t v) { memcpy(p, &v, 8); }
+#endif
+
+// --- Loads: wire order -> host value ---
+#if CAN_HOST_BIG_ENDIAN
+static inline uint16_t load_le16(const void *p) { return CAN_BSWAP16(can_native16(p)); }
+static inline uint32_t load_le32(const void *p) { return CAN_BSWAP32(can_native32(p)); }
+static inline uint64_t load_le64(const void *p) { return CAN_BSWAP64(can_native64(p)); }
+static inline uint16_t load_be16(const void *p) { return can_native16(p); }
+static inline uint32_t load_be32(const void *p) { return can_native32(p); }
+static inline uint64_t load_be64(const void *p) { return can_native64(p); }
+#else
+static inline uint16_t load_le16(const void *p) { return can_native16(p); }
+static inline uint32_t load_le32(const void *p) { return can_native32(p); }
+static inline uint64_t load_le64(const void *p) { return can_native64(p); }
+static inline uint16_t load_be16(const void *p) { return CAN_BSWAP16(can_native16(p)); }
+static inline uint32_t load_be32(const void *p) { return CAN_BSWAP32(can_native32(p)); }
+static inline uint64_t load_be64(const void *p) { return CAN_BSWAP64(can_native64(p)); }
+#endif
+
+// Signed variants (two's complement conversion is well defined on GCC/Clang)
+static inline int16_t load_le16s(const void *p) { return (int16_t)load_le16(p); }
+static inline int16_t load_be16s(const void *p) { return (int16_t)load_be16(p); }
+static inline int32_t load_le32s(const void *p) { return (int32_t)load_le32(p); }
+static inline int32_t load_be32s(const void *p) { return (int32_t)load_be32(p); }
+static inline int64_t load_le64s(const void *p) { return (int64_t)load_le64(p); }
+static inline int64_t load_be64s(const void *p) { return (int64_t)load_be64(p); }
+
+// --- Stores: host value -> wire order ---
+#if CAN_HOST_BIG_ENDIAN
+static inline void store_le16(void *p, uint16_t v) { can_native_store16(p, CAN_BSWAP16(v)); }
+static inline void store_le32(void *p, uint32_t v) { can_native_store32(p, CAN_BSWAP32(v)); }
+static inline void store_le64(void *p, uint64_t v) { can_native_store64(p, CAN_BSWAP64(v)); }
+static inline void store_be16(void *p, uint16_t v) { can_native_store16(p, v); }
+static inline void store_be32(void *p, uint32_t v) { can_native_store32(p, v); }
+static inline void store_be64(void *p, uint64_t v) { can_native_store64(p, v); }
+#else
+static inline void store_le16(void *p, uint16_t v) { can_native_store16(p, v); }
+static inline void store_le32(void *p, uint32_t v) { can_native_store32(p, v); }
+static inline void store_le64(void *p, uint64_t v) { can_native_store64(p, v); }
+static inline void store_be16(void *p, uint16_t v) { can_native_store16(p, CAN_BSWAP16(v)); }
+static inline void store_be32(void *p, uint32_t v) { can_native_store32(p, CAN_BSWAP32(v)); }
+static inline void store_be64(void *p, uint64_t v) { can_native_store64(p, CAN_BSWAP64(v)); }
+#endif
+
+// --- Bitfield extract from an 8-byte CAN payload ---
+// Intel (DBC @1): start_bit is the LSB, bits counted from byte 0 bit 0 upwards.
+// Motorola (DBC @0): start_bit is the MSB in "byte*8 + bit" numbering.
+// With constant arguments each call is one load (+ bswap), one shift, one mask.
+static inline uint64_t can_mask64(int length) {
+    return (length >= 64) ? ~0ull : ((1ull << length) - 1);
+}
+
+static inline uint64_t extract_bits_le(const uint8_t *data, int start_bit, int length) {
+    return (load_le64(data) >> start_bit) & can_mask64(length);
+}
+
+static inline uint64_t extract_bits_be(const uint8_t *data, int start_bit, int length) {
+    // In the big-endian 64-bit word byte 0 is the top byte
+    int msb = (7 - start_bit / 8) * 8 + (start_bit % 8);
+    return (load_be64(data) >> (msb - (length - 1))) & can_mask64(length);
+}
+
+// Sign-extend the low 'length' bits: move the sign bit to bit 63, shift back
+static inline int64_t sign_extend64(uint64_t raw, int length) {
+    return (int64_t)(raw << (64 - length)) >> (64 - length);
+}
+
+#endif // CAN_ENDIAN_H
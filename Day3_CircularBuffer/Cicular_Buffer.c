@@ -1,6 +1,19 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 
 // Define buffer size (Power of 2 for optimization)
 #define BUFFER_SIZE 8
@@ -54,7 +67,568 @@ float RB_GetAverage(RingBuffer *rb) {
     return 0.0f; 
 }
 
-int main() {
+// Task 4: Lock-Free SPSC Ring Buffer (ISR / Thread -> Task Handoff)
+// In production one side WRITES (ADC ISR or producer thread) while another
+// side READS (control task). RingBuffer above shares 'head' and 'count'
+// between both sides, which is a data race. The single-producer /
+// single-consumer version gives each index exactly one writer:
+//   - head: written only by the producer, tail: written only by the consumer.
+//   - Indices run freely (uint32_t wrap-around); 'head - tail' is the fill level.
+//   - The producer publishes samples with a RELEASE store of head. The consumer
+//     reads head with ACQUIRE, so the sample data is visible before the index.
+//   - head and tail live on separate cache lines so the two cores do not
+//     ping-pong one line ("false sharing"). Each side also caches the other's
+//     index and only re-reads it when the cached value says full/empty.
+
+#define SPSC_SIZE 4096                  // Power of 2
+#define SPSC_MASK (SPSC_SIZE - 1)
+#define CACHE_LINE 64
+
+typedef struct {
+    // Producer side
+    _Alignas(CACHE_LINE) _Atomic uint32_t head;
+    uint32_t tail_cache;
+    // Consumer side
+    _Alignas(CACHE_LINE) _Atomic uint32_t tail;
+    uint32_t head_cache;
+    // Storage
+    _Alignas(CACHE_LINE) float buffer[SPSC_SIZE];
+} SPSC_RingBuffer;
+
+void SPSC_Init(SPSC_RingBuffer *rb) {
+    atomic_init(&rb->head, 0);
+    atomic_init(&rb->tail, 0);
+    rb->tail_cache = 0;
+    rb->head_cache = 0;
+}
+
+// Producer: push up to 'n' samples, returns how many fit
+size_t SPSC_Push(SPSC_RingBuffer *rb, const float *samples, size_t n) {
+    uint32_t head = atomic_load_explicit(&rb->head, memory_order_relaxed); // Own index
+    uint32_t free_slots = SPSC_SIZE - (head - rb->tail_cache);
+    if (free_slots < n) {
+        rb->tail_cache = atomic_load_explicit(&rb->tail, memory_order_acquire);
+        free_slots = SPSC_SIZE - (head - rb->tail_cache);
+        if (n > free_slots) n = free_slots;
+    }
+    if (n == 0) return 0;
+
+    // Copy in at most two pieces (before and after the wrap point)
+    uint32_t start = head & SPSC_MASK;
+    size_t first = (n < (size_t)(SPSC_SIZE - start)) ? n : (size_t)(SPSC_SIZE - start);
+    memcpy(&rb->buffer[start], samples, first * sizeof(float));
+    memcpy(&rb->buffer[0], samples + first, (n - first) * sizeof(float));
+
+    atomic_store_explicit(&rb->head, head + (uint32_t)n, memory_order_release); // Publish
+    return n;
+}
+
+// Consumer: pop up to 'n' samples, returns how many were available
+size_t SPSC_Pop(SPSC_RingBuffer *rb, float *samples, size_t n) {
+    uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed); // Own index
+    uint32_t available = rb->head_cache - tail;
+    if (available < n) {
+        rb->head_cache = atomic_load_explicit(&rb->head, memory_order_acquire);
+        available = rb->head_cache - tail;
+        if (n > available) n = available;
+    }
+    if (n == 0) return 0;
+
+    uint32_t start = tail & SPSC_MASK;
+    size_t first = (n < (size_t)(SPSC_SIZE - start)) ? n : (size_t)(SPSC_SIZE - start);
+    memcpy(samples, &rb->buffer[start], first * sizeof(float));
+    memcpy(samples + first, &rb->buffer[0], (n - first) * sizeof(float));
+
+    atomic_store_explicit(&rb->tail, tail + (uint32_t)n, memory_order_release); // Free the slots
+    return n;
+}
+
+// Task 5: O(1) Windowed Statistics
+// RB_GetAverage() re-sums the whole buffer on every call: O(N) per query.
+// For 1k-64k sample windows queried at a high rate that is far too slow.
+// RB_Stats keeps every statistic up to date inside the add instead:
+//   - Running sum and sum of squares: add the new sample, subtract the one it
+//     overwrites. Kahan compensation carries the rounding error of each add,
+//     and a full re-sum every RB_STATS_RESUM_WINDOWS windows resets any drift
+//     that remains (amortized O(1)).
+//   - Min/Max: monotonic deques of sample sequence numbers. The max deque only
+//     keeps samples that could still become the maximum (values decreasing
+//     front to back). The front is the answer, and expired samples fall off
+//     the front. Each sample is pushed and popped at most once: amortized O(1).
+// Storage is provided by the caller (no malloc), capacity must be a power of 2.
+
+#define RB_STATS_RESUM_WINDOWS 16
+
+typedef struct {
+    double sum;
+    double comp;    // Kahan compensation: low-order bits lost by the last add
+} Kahan_Acc;
+
+static inline void Kahan_Add(Kahan_Acc *k, double x) {
+    double y = x - k->comp;
+    double t = k->sum + y;
+    k->comp = (t - k->sum) - y;
+    k->sum = t;
+}
+
+typedef struct {
+    float *buffer;          // [capacity] samples
+    uint32_t *max_q;        // [capacity] deque of sequence numbers
+    uint32_t *min_q;        // [capacity]
+    uint32_t capacity, mask;
+    uint32_t count;
+    uint32_t seq;           // Sequence number of the NEXT sample (also the write position)
+    uint32_t max_head, max_tail, min_head, min_tail; // Free-running deque indices
+    uint32_t since_resum;
+    Kahan_Acc sum, sum_sq;
+} RB_Stats;
+
+bool RB_Stats_Init(RB_Stats *st, float *buffer, uint32_t *max_q, uint32_t *min_q, uint32_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) return false; // Power of 2 only
+    memset(st, 0, sizeof(*st));
+    st->buffer = buffer;
+    st->max_q = max_q;
+    st->min_q = min_q;
+    st->capacity = capacity;
+    st->mask = capacity - 1;
+    return true;
+}
+
+static void RB_Stats_Resum(RB_Stats *st) {
+    Kahan_Acc sum = { 0.0, 0.0 }, sum_sq = { 0.0, 0.0 };
+    for (uint32_t i = 0; i < st->count; i++) {
+        double x = st->buffer[(st->seq - 1 - i) & st->mask];
+        Kahan_Add(&sum, x);
+        Kahan_Add(&sum_sq, x * x);
+    }
+    st->sum = sum;
+    st->sum_sq = sum_sq;
+    st->since_resum = 0;
+}
+
+void RB_Stats_AddSample(RB_Stats *st, float sample) {
+    uint32_t pos = st->seq & st->mask;
+
+    // 1. Running sums: remove the sample being overwritten
+    if (st->count == st->capacity) {
+        double old = st->buffer[pos];
+        Kahan_Add(&st->sum, -old);
+        Kahan_Add(&st->sum_sq, -old * old);
+    } else {
+        st->count++;
+    }
+    st->buffer[pos] = sample;
+    Kahan_Add(&st->sum, sample);
+    Kahan_Add(&st->sum_sq, (double)sample * sample);
+
+    // 2. Deques: drop the expired front (left the window), then drop back
+    //    entries that the new sample dominates, then append the new sample
+    uint32_t oldest_valid = st->seq - st->count + 1;
+    if (st->max_head != st->max_tail && st->max_q[st->max_head & st->mask] - oldest_valid > st->seq - oldest_valid) st->max_head++;
+    if (st->min_head != st->min_tail && st->min_q[st->min_head & st->mask] - oldest_valid > st->seq - oldest_valid) st->min_head++;
+    while (st->max_head != st->max_tail && st->buffer[st->max_q[(st->max_tail - 1) & st->mask] & st->mask] <= sample) st->max_tail--;
+    while (st->min_head != st->min_tail && st->buffer[st->min_q[(st->min_tail - 1) & st->mask] & st->mask] >= sample) st->min_tail--;
+    st->max_q[st->max_tail++ & st->mask] = st->seq;
+    st->min_q[st->min_tail++ & st->mask] = st->seq;
+
+    st->seq++;
+
+    // 3. Periodic exact re-sum (amortized O(1))
+    if (++st->since_resum >= RB_STATS_RESUM_WINDOWS * st->capacity) {
+        RB_Stats_Resum(st);
+    }
+}
+
+// All queries are O(1)
+static inline float RB_Stats_Average(const RB_Stats *st) {
+    return (st->count == 0) ? 0.0f : (float)(st->sum.sum / st->count);
+}
+
+static inline float RB_Stats_Variance(const RB_Stats *st) {
+    if (st->count == 0) return 0.0f;
+    double mean = st->sum.sum / st->count;
+    double var = st->sum_sq.sum / st->count - mean * mean;
+    return (var > 0.0) ? (float)var : 0.0f; // Population variance
+}
+
+static inline float RB_Stats_Max(const RB_Stats *st) {
+    return (st->count == 0) ? 0.0f : st->buffer[st->max_q[st->max_head & st->mask] & st->mask];
+}
+
+static inline float RB_Stats_Min(const RB_Stats *st) {
+    return (st->count == 0) ? 0.0f : st->buffer[st->min_q[st->min_head & st->mask] & st->mask];
+}
+
+// Baseline: the RB_GetAverage() approach on the same storage, O(N) per query
+float RB_Stats_RecomputeAverage(const RB_Stats *st) {
+    if (st->count == 0) return 0.0f;
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < st->count; i++) {
+        sum += st->buffer[i];
+    }
+    return sum / st->count;
+}
+
+// Task 6: Multi-Channel Ring Buffer (Compile-Time Generated)
+// A pack samples 96+ channels per tick. 96 separate RingBuffer structs are an
+// "array of structures": every channel has its own head/count and every
+// average is its own little loop. DEFINE_MC_RING() generates a type where
+//   - element type, accumulator type, channel count and capacity are fixed
+//     at compile time (float volts, int16_t ADC counts, Q-format int32_t ...)
+//   - one shared head/count, and storage is slot-major: each time slot is a
+//     contiguous row over all channels (data[slot][channel])
+//   - this is deliberately NOT per-channel arrays (data[channel][slot]). A tick
+//     delivers one sample of EVERY channel, so a push is a single row memcpy
+//     instead of CHANNELS scattered stores. "Average all channels" then adds
+//     whole rows: the channel loop is contiguous and fixed-length, and the
+//     compiler turns it into SIMD adds (8 floats per AVX2 instruction, 4 with
+//     SSE/NEON). Per-channel arrays would need a horizontal reduction per
+//     channel, which a float sum cannot vectorize without reordering it.
+// Summation order per channel is the same as RB_GetAverage(), so a float
+// instance gives bit-identical averages to 96 RingBuffers.
+
+#define DEFINE_MC_RING(Name, elem_t, acc_t, CHANNELS, CAPACITY)                          \
+    _Static_assert(((CAPACITY) & ((CAPACITY) - 1)) == 0, #Name ": capacity must be a power of 2"); \
+    typedef struct {                                                                     \
+        elem_t data[CAPACITY][CHANNELS];                                                 \
+        uint32_t head;                                                                   \
+        uint32_t count;                                                                  \
+    } Name;                                                                              \
+                                                                                         \
+    static inline void Name##_Init(Name *rb) {                                           \
+        memset(rb, 0, sizeof(*rb));                                                      \
+    }                                                                                    \
+                                                                                         \
+    /* One sample for every channel: a single row copy */                                \
+    static inline void Name##_Push(Name *rb, const elem_t *frame) {                      \
+        memcpy(rb->data[rb->head], frame, sizeof(rb->data[0]));                          \
+        rb->head = (rb->head + 1) & ((CAPACITY) - 1);                                    \
+        if (rb->count < (CAPACITY)) rb->count++;                                         \
+    }                                                                                    \
+                                                                                         \
+    static inline void Name##_AverageAll(const Name *rb, float *avg) {                   \
+        acc_t acc[CHANNELS];                                                             \
+        for (int ch = 0; ch < (CHANNELS); ch++) acc[ch] = 0;                             \
+        if (rb->count == 0) {                                                            \
+            for (int ch = 0; ch < (CHANNELS); ch++) avg[ch] = 0.0f;                      \
+            return;                                                                      \
+        }                                                                                \
+        for (uint32_t row = 0; row < rb->count; row++) {                                 \
+            const elem_t *r = rb->data[row];                                             \
+            for (int ch = 0; ch < (CHANNELS); ch++) acc[ch] += (acc_t)r[ch];             \
+        }                                                                                \
+        float n = (float)rb->count;                                                      \
+        for (int ch = 0; ch < (CHANNELS); ch++) avg[ch] = (float)acc[ch] / n;            \
+    }
+
+#define PACK_CHANNELS 96
+
+DEFINE_MC_RING(PackVoltRing, float,   float,   PACK_CHANNELS, BUFFER_SIZE) // Same window as RingBuffer
+DEFINE_MC_RING(PackAdcRing,  int16_t, int32_t, PACK_CHANNELS, 64)          // Raw 12-bit ADC counts
+DEFINE_MC_RING(PackQ10Ring,  int32_t, int64_t, PACK_CHANNELS, 16)          // Q10 fixed point (mV * 1024)
+
+// Baselines for the integer rings: one independent ring per channel, same
+// element type and window (the "96 x RingBuffer" layout)
+DEFINE_MC_RING(AdcChannelRing, int16_t, int32_t, 1, 64)
+DEFINE_MC_RING(Q10ChannelRing, int32_t, int64_t, 1, 16)
+
+// Task 7: Persistent Ring Buffer (mmap-Backed, Crash-Safe)
+// A data logger must keep the last N samples when the process crashes. Here the
+// ring lives in a file mapped with MAP_SHARED. Every store goes straight into the
+// kernel page cache, which outlives the process, so a SIGKILL or segfault loses
+// nothing that was already appended. Power loss only keeps what reached the disk;
+// PRB_Sync() (msync) controls that.
+//   - Hot path: PRB_Append() does one float store and one 64-bit release store.
+//     It makes no syscalls and allocates nothing.
+//   - Head and count are not stored separately. One 64-bit sequence number (the
+//     number of samples ever written) holds both: head = seq % capacity and
+//     count = min(seq, capacity). A single aligned atomic store publishes both,
+//     so a reader never sees a head from one append and a count from another.
+//   - The sample is stored BEFORE seq is published (release), so a recovered
+//     window never includes a slot that was not written.
+//   - In a full ring, the slot at head is both the oldest sample and the next
+//     one to be overwritten. A writer killed between the two stores leaves a
+//     newer value there, so recovery returns at most capacity - 1 samples.
+
+#define PRB_MAGIC       0x31425250u // "PRB1"
+#define PRB_HEADER_SIZE 64          // Samples start on their own cache line
+
+typedef struct {
+    _Atomic uint32_t magic;     // Written last: half-initialized files are rejected
+    uint32_t capacity;          // Samples, power of 2
+    uint32_t elem_size;         // sizeof(float): rejects files from other builds
+    uint32_t reserved;
+    _Atomic uint64_t seq;       // Samples ever appended (head + count in one word)
+} PRB_Header;
+
+_Static_assert(sizeof(PRB_Header) <= PRB_HEADER_SIZE, "PRB header does not fit");
+
+typedef struct {
+    PRB_Header *hdr;
+    float *data;
+    uint64_t seq;               // Writer's private copy: no atomic load per append
+    uint32_t mask;
+    size_t map_size;
+} PersistentRB;
+
+static size_t PRB_FileSize(uint32_t capacity) {
+    return PRB_HEADER_SIZE + (size_t)capacity * sizeof(float);
+}
+
+static bool PRB_HeaderValid(const PRB_Header *hdr, uint32_t capacity) {
+    return atomic_load_explicit(&hdr->magic, memory_order_acquire) == PRB_MAGIC &&
+           hdr->capacity == capacity && hdr->elem_size == sizeof(float);
+}
+
+void PRB_Close(PersistentRB *rb) {
+    if (rb->hdr != NULL) munmap(rb->hdr, rb->map_size);
+    memset(rb, 0, sizeof(*rb));
+}
+
+// Open (or create) the ring file. If it holds a valid ring of the same capacity,
+// appending continues after the last published sample and *recovered is set.
+// Only an empty file, or one whose header was never published (magic still 0),
+// is initialized. Anything else with the wrong size or header is refused, so a
+// wrong capacity can never wipe the crash data this ring exists to keep.
+bool PRB_Open(PersistentRB *rb, const char *path, uint32_t capacity, bool *recovered) {
+    memset(rb, 0, sizeof(*rb));
+    *recovered = false;
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) return false;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    rb->map_size = PRB_FileSize(capacity);
+    bool reuse = ((size_t)st.st_size == rb->map_size);
+    if (!reuse && (st.st_size != 0 || ftruncate(fd, (off_t)rb->map_size) != 0)) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, rb->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid after close()
+    if (map == MAP_FAILED) return false;
+
+    rb->hdr = (PRB_Header *)map;
+    rb->data = (float *)((uint8_t *)map + PRB_HEADER_SIZE);
+    rb->mask = capacity - 1;
+
+    if (reuse && PRB_HeaderValid(rb->hdr, capacity)) {
+        rb->seq = atomic_load_explicit(&rb->hdr->seq, memory_order_acquire);
+        *recovered = true;
+    } else if (reuse && atomic_load_explicit(&rb->hdr->magic, memory_order_acquire) != 0) {
+        PRB_Close(rb); // Another ring (capacity, element size) or not a ring file
+        return false;
+    } else {
+        // Fresh ring: fill in the header, then publish it by writing the magic
+        atomic_store_explicit(&rb->hdr->magic, 0, memory_order_relaxed);
+        rb->hdr->capacity = capacity;
+        rb->hdr->elem_size = sizeof(float);
+        rb->hdr->reserved = 0;
+        atomic_store_explicit(&rb->hdr->seq, 0, memory_order_relaxed);
+        atomic_store_explicit(&rb->hdr->magic, PRB_MAGIC, memory_order_release);
+        rb->seq = 0;
+    }
+    return true;
+}
+
+// Hot path: one store for the sample, one release store to publish it
+static inline void PRB_Append(PersistentRB *rb, float sample) {
+    rb->data[rb->seq & rb->mask] = sample;
+    rb->seq++;
+    atomic_store_explicit(&rb->hdr->seq, rb->seq, memory_order_release);
+}
+
+// Push dirty pages toward the disk. MS_ASYNC only schedules writeback;
+// MS_SYNC waits until the data is on stable storage.
+bool PRB_Sync(PersistentRB *rb, bool wait) {
+    return msync(rb->hdr, rb->map_size, wait ? MS_SYNC : MS_ASYNC) == 0;
+}
+
+// Reader tool: copy the newest window (oldest sample first) out of a ring file.
+// Works on the file a crashed writer left behind, or on a live one: like a
+// seqlock reader, it re-reads seq after the copy. Samples the writer may have
+// overwritten meanwhile (including its in-flight slot) are dropped from the
+// front of the window. If the writer lapped the whole copy, it retries.
+bool PRB_Recover(const char *path, float *out, uint32_t max_out, uint32_t *count, uint64_t *seq) {
+    *count = 0;
+    *seq = 0;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < PRB_HEADER_SIZE) {
+        close(fd);
+        return false;
+    }
+    size_t map_size = (size_t)st.st_size;
+    void *map = mmap(NULL, map_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const PRB_Header *hdr = (const PRB_Header *)map;
+    uint32_t capacity = hdr->capacity;
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        map_size != PRB_FileSize(capacity) || !PRB_HeaderValid(hdr, capacity)) {
+        munmap(map, map_size);
+        return false;
+    }
+    const float *data = (const float *)((const uint8_t *)map + PRB_HEADER_SIZE);
+
+    for (int attempt = 0; attempt < 16; attempt++) {
+        uint64_t s = atomic_load_explicit(&hdr->seq, memory_order_acquire);
+        uint32_t n = (s < capacity) ? (uint32_t)s : capacity - 1; // Skip the in-flight slot
+        if (n > max_out) n = max_out;
+
+        // Oldest sample first: at most two contiguous pieces
+        uint32_t start = (uint32_t)((s - n) & (capacity - 1));
+        uint32_t first = (n < capacity - start) ? n : capacity - start;
+        memcpy(out, data + start, first * sizeof(float));
+        memcpy(out + first, data, (n - first) * sizeof(float));
+
+        // Sample g survived the copy if the writer has not reached g + capacity:
+        // published up to s2, plus possibly slot s2 in flight
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t s2 = atomic_load_explicit(&hdr->seq, memory_order_relaxed);
+        uint64_t oldest_ok = (s2 + 1 > capacity) ? s2 + 1 - capacity : 0;
+        uint64_t drop = (oldest_ok > s - n) ? oldest_ok - (s - n) : 0;
+        if (drop >= n && n > 0) continue; // Lapped during the copy: try again
+        memmove(out, out + drop, (n - drop) * sizeof(float));
+
+        munmap(map, map_size);
+        *count = n - (uint32_t)drop;
+        *seq = s;
+        return true;
+    }
+    munmap(map, map_size);
+    return false;
+}
+
+// --- Two-thread stress test / benchmark ---
+static double Bench_NowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef struct {
+    SPSC_RingBuffer *rb;
+    uint32_t total;         // Samples to transfer (< 2^24 so floats stay exact)
+    size_t max_batch;       // Random bulk sizes in [1, max_batch]
+    double *t_push;         // Optional: per-sample push time (latency run)
+    double *t_pop;          // Optional: per-sample pop time
+    bool paced;             // Wait until the queue drains before each push
+    uint32_t errors;        // Consumer: out-of-order or corrupted samples
+} SPSC_Test;
+
+static void *SPSC_Producer(void *arg) {
+    SPSC_Test *t = (SPSC_Test *)arg;
+    float chunk[256];
+    uint32_t next = 0, seed = 12345;
+    while (next < t->total) {
+        seed = seed * 1103515245u + 12345u;
+        size_t n = 1 + (seed >> 16) % t->max_batch;
+        if (n > t->total - next) n = t->total - next;
+        for (size_t i = 0; i < n; i++) chunk[i] = (float)(next + i);
+        while (t->paced && atomic_load_explicit(&t->rb->tail, memory_order_acquire) != next) {
+            sched_yield(); // Measure the handoff itself, not time spent queued
+        }
+        if (t->t_push != NULL) t->t_push[next] = Bench_NowSec();
+
+        size_t done = 0;
+        while (done < n) {
+            size_t pushed = SPSC_Push(t->rb, chunk + done, n - done);
+            if (pushed == 0) sched_yield(); // Full: let the consumer run
+            done += pushed;
+        }
+        next += (uint32_t)n;
+    }
+    return NULL;
+}
+
+static void *SPSC_Consumer(void *arg) {
+    SPSC_Test *t = (SPSC_Test *)arg;
+    float chunk[256];
+    uint32_t expected = 0;
+    while (expected < t->total) {
+        size_t n = SPSC_Pop(t->rb, chunk, sizeof(chunk) / sizeof(chunk[0]));
+        if (n == 0) {
+            sched_yield(); // Empty: let the producer run
+            continue;
+        }
+        double now = (t->t_pop != NULL) ? Bench_NowSec() : 0.0;
+        for (size_t i = 0; i < n; i++) {
+            if (chunk[i] != (float)expected) t->errors++;
+            if (t->t_pop != NULL) t->t_pop[expected] = now;
+            expected++;
+        }
+    }
+    return NULL;
+}
+
+static int Compare_Double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// --- Persistent ring: kill-and-recover test ---
+// Value written for sequence number s (floats are exact below 2^24)
+static float PRB_TestValue(uint64_t s) {
+    return (float)(s & 0xFFFFFF);
+}
+
+// Fork a writer that appends as fast as it can, SIGKILL it after delay_us, then
+// check that the recovered window is exactly the samples before the published seq.
+static bool PRB_KillAndRecover(const char *path, uint32_t capacity, unsigned delay_us,
+                               float *window, uint64_t *seq_out) {
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        PersistentRB w;
+        bool recovered;
+        if (!PRB_Open(&w, path, capacity, &recovered)) _exit(1);
+        for (;;) PRB_Append(&w, PRB_TestValue(w.seq)); // Never returns: killed mid-append
+    }
+    struct timespec ts = { 0, (long)delay_us * 1000L };
+    nanosleep(&ts, NULL);
+    kill(pid, SIGKILL);
+    int status;
+    waitpid(pid, &status, 0);
+    if (!WIFSIGNALED(status)) return false; // Writer failed to open the file
+
+    uint32_t n;
+    uint64_t s;
+    if (!PRB_Recover(path, window, capacity, &n, &s)) return false;
+    *seq_out = s;
+    if (n != ((s < capacity) ? s : capacity - 1)) return false;
+    for (uint32_t i = 0; i < n; i++) {
+        if (window[i] != PRB_TestValue(s - n + i)) return false;
+    }
+    return true;
+}
+
+// Reader tool: ./Circular_Buffer --recover <ring file>
+static int PRB_RecoverTool(const char *path) {
+    static float window[1u << 24];
+    uint32_t n;
+    uint64_t s;
+    if (!PRB_Recover(path, window, 1u << 24, &n, &s)) {
+        printf("%s: not a valid ring file\n", path);
+        return 1;
+    }
+    printf("%s: %llu samples ever written, %u in window\n", path, (unsigned long long)s, n);
+    uint32_t show = (n < 8) ? n : 8;
+    for (uint32_t i = n - show; i < n; i++) {
+        printf("  [%llu] %.4f\n", (unsigned long long)(s - n + i), window[i]);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "--recover") == 0) return PRB_RecoverTool(argv[2]);
+
     RingBuffer rb;
     RB_Init(&rb);
 
@@ -86,5 +660,378 @@ int main() {
     // Sum = 116, Avg = 14.5
     printf("Average (Expect 14.5): %.2f\n", avg);
     
+    printf("\n--- Lock-Free SPSC Ring Buffer (2 Threads) ---\n");
+    static SPSC_RingBuffer spsc;
+    const size_t batches[] = { 1, 16, 256 };
+    for (int b = 0; b < 3; b++) {
+        SPSC_Init(&spsc);
+        SPSC_Test test = { &spsc, 10u * 1000u * 1000u, batches[b], NULL, NULL, false, 0 };
+        pthread_t prod, cons;
+        double t0 = Bench_NowSec();
+        pthread_create(&cons, NULL, SPSC_Consumer, &test);
+        pthread_create(&prod, NULL, SPSC_Producer, &test);
+        pthread_join(prod, NULL);
+        pthread_join(cons, NULL);
+        double dt = Bench_NowSec() - t0;
+        printf("Bulk 1..%-3zu: %u samples | %7.1f M samples/s | Stress check: %s\n", batches[b], test.total,
+               test.total / dt / 1e6, test.errors == 0 ? "PASS (in order, no loss)" : "FAIL");
+    }
+
+    // Handoff latency: time from push to pop of each sample, one sample in flight
+    const uint32_t lat_samples = 200000u;
+    double *t_push = calloc(lat_samples, sizeof(double));
+    double *t_pop = calloc(lat_samples, sizeof(double));
+    if (t_push == NULL || t_pop == NULL) {
+        printf("Out of memory for latency run\n");
+        return 1;
+    }
+    SPSC_Init(&spsc);
+    SPSC_Test lat = { &spsc, lat_samples, 1, t_push, t_pop, true, 0 };
+    pthread_t prod, cons;
+    pthread_create(&cons, NULL, SPSC_Consumer, &lat);
+    pthread_create(&prod, NULL, SPSC_Producer, &lat);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    for (uint32_t i = 0; i < lat_samples; i++) t_pop[i] = (t_pop[i] - t_push[i]) * 1e9;
+    qsort(t_pop, lat_samples, sizeof(double), Compare_Double);
+    printf("Handoff latency (bulk 1): p50 %.0f ns | p99 %.0f ns | max %.0f ns\n",
+           t_pop[lat_samples / 2], t_pop[lat_samples * 99 / 100], t_pop[lat_samples - 1]);
+    free(t_push);
+    free(t_pop);
+
+    printf("\n--- O(1) Windowed Statistics ---\n");
+    #define MAX_WINDOW 65536
+    static float win_buf[MAX_WINDOW];
+    static uint32_t win_max_q[MAX_WINDOW], win_min_q[MAX_WINDOW];
+    RB_Stats st;
+
+    // 1. Same test as above on an 8-sample window
+    RB_Stats_Init(&st, win_buf, win_max_q, win_min_q, 8);
+    for (int i = 10; i <= 18; i++) RB_Stats_AddSample(&st, (float)i);
+    printf("Window 8 after 10..18: Avg %.2f (Expect 14.5) | Min %.1f | Max %.1f | Var %.2f (Expect 5.25)\n",
+           RB_Stats_Average(&st), RB_Stats_Min(&st), RB_Stats_Max(&st), RB_Stats_Variance(&st));
+
+    // 2. Random walk vs brute-force recompute after every sample
+    RB_Stats_Init(&st, win_buf, win_max_q, win_min_q, 1024);
+    srand(7);
+    int stat_errors = 0;
+    float cell_v = 3.3f;
+    for (int i = 0; i < 200000; i++) {
+        cell_v += ((float)rand() / RAND_MAX - 0.5f) * 0.01f;
+        RB_Stats_AddSample(&st, cell_v);
+        if (i % 97 != 0) continue;
+        double sum = 0.0, sum_sq = 0.0;
+        float mn = win_buf[0], mx = win_buf[0];
+        for (uint32_t k = 0; k < st.count; k++) {
+            float x = win_buf[k];
+            sum += x;
+            sum_sq += (double)x * x;
+            if (x < mn) mn = x;
+            if (x > mx) mx = x;
+        }
+        double mean = sum / st.count;
+        double var = sum_sq / st.count - mean * mean;
+        if (fabs(RB_Stats_Average(&st) - mean) > 1e-5 || fabs(RB_Stats_Variance(&st) - var) > 1e-6 ||
+            RB_Stats_Min(&st) != mn || RB_Stats_Max(&st) != mx) {
+            stat_errors++;
+        }
+    }
+    printf("O(1) stats vs brute force (200k samples, window 1024): %s\n", stat_errors == 0 ? "MATCH" : "MISMATCH!");
+
+    // 3. Why compensation: a naive float running sum drifts away over time
+    float naive_sum = 0.0f;
+    RB_Stats_Init(&st, win_buf, win_max_q, win_min_q, 1024);
+    for (uint32_t i = 0; i < 10000000u; i++) {
+        float x = 3.3f + 0.01f * ((float)rand() / RAND_MAX);
+        if (st.count == st.capacity) naive_sum -= win_buf[st.seq & st.mask];
+        naive_sum += x;
+        RB_Stats_AddSample(&st, x);
+    }
+    double exact = 0.0;
+    for (uint32_t k = 0; k < st.count; k++) exact += win_buf[k];
+    printf("After 10M samples: avg error Kahan %.3f uV | naive float running sum %.3f uV\n",
+           fabs(RB_Stats_Average(&st) - exact / st.count) * 1e6, fabs(naive_sum / st.count - exact / st.count) * 1e6);
+
+    // 4. Benchmark: add + query average, O(1) vs recompute
+    printf("\n--- Benchmark: Add + Average Query ---\n");
+    const uint32_t windows[] = { 1024, 4096, 16384, 65536 };
+    for (int w = 0; w < 4; w++) {
+        RB_Stats_Init(&st, win_buf, win_max_q, win_min_q, windows[w]);
+        for (uint32_t i = 0; i < windows[w]; i++) RB_Stats_AddSample(&st, 3.3f);
+        float acc = 0.0f;
+        const int q_recompute = 20000, q_fast = 5000000;
+
+        double t0 = Bench_NowSec();
+        for (int i = 0; i < q_recompute; i++) {
+            RB_Stats_AddSample(&st, 3.3f + 0.001f * (float)(i & 7));
+            acc += RB_Stats_RecomputeAverage(&st);
+        }
+        double t_re = (Bench_NowSec() - t0) / q_recompute;
+
+        t0 = Bench_NowSec();
+        for (int i = 0; i < q_fast; i++) {
+            RB_Stats_AddSample(&st, 3.3f + 0.001f * (float)(i & 7));
+            acc += RB_Stats_Average(&st);
+        }
+        double t_fast = (Bench_NowSec() - t0) / q_fast;
+        printf("Window %5u: Recompute %9.1f ns | O(1) %5.1f ns | Speedup %6.0fx [%.0f]\n",
+               windows[w], t_re * 1e9, t_fast * 1e9, t_re / t_fast, acc);
+    }
+
+    printf("\n--- Multi-Channel Ring Buffer (96 Channels) ---\n");
+    static RingBuffer singles[PACK_CHANNELS];
+    static PackVoltRing pack_ring;
+    static PackAdcRing adc_ring;
+    static PackQ10Ring q10_ring;
+    static AdcChannelRing adc_singles[PACK_CHANNELS];
+    static Q10ChannelRing q10_singles[PACK_CHANNELS];
+    float frame[PACK_CHANNELS], avg_single[PACK_CHANNELS], avg_pack[PACK_CHANNELS];
+    int16_t adc_frame[PACK_CHANNELS];
+    int32_t q10_frame[PACK_CHANNELS];
+
+    for (int ch = 0; ch < PACK_CHANNELS; ch++) RB_Init(&singles[ch]);
+    PackVoltRing_Init(&pack_ring);
+    PackAdcRing_Init(&adc_ring);
+    PackQ10Ring_Init(&q10_ring);
+    for (int ch = 0; ch < PACK_CHANNELS; ch++) {
+        AdcChannelRing_Init(&adc_singles[ch]);
+        Q10ChannelRing_Init(&q10_singles[ch]);
+    }
+
+    // Feed identical data; the float instance must match 96 RingBuffers bit for bit
+    int mc_mismatch = 0;
+    for (int tick = 0; tick < 1000; tick++) {
+        for (int ch = 0; ch < PACK_CHANNELS; ch++) {
+            frame[ch] = 3.2f + 0.001f * (float)((tick * 7 + ch * 13) % 101);
+            adc_frame[ch] = (int16_t)(2048 + (tick * 3 + ch) % 200);
+            q10_frame[ch] = (int32_t)(3300 * 1024 + (tick * 11 + ch) % 5000);
+            RB_AddSample(&singles[ch], frame[ch]);
+            AdcChannelRing_Push(&adc_singles[ch], &adc_frame[ch]);
+            Q10ChannelRing_Push(&q10_singles[ch], &q10_frame[ch]);
+        }
+        PackVoltRing_Push(&pack_ring, frame);
+        PackAdcRing_Push(&adc_ring, adc_frame);
+        PackQ10Ring_Push(&q10_ring, q10_frame);
+
+        PackVoltRing_AverageAll(&pack_ring, avg_pack);
+        for (int ch = 0; ch < PACK_CHANNELS; ch++) {
+            if (avg_pack[ch] != RB_GetAverage(&singles[ch])) mc_mismatch++;
+        }
+    }
+    float avg_adc[PACK_CHANNELS], avg_q10[PACK_CHANNELS];
+    PackAdcRing_AverageAll(&adc_ring, avg_adc);
+    PackQ10Ring_AverageAll(&q10_ring, avg_q10);
+    int int_mismatch = 0;
+    for (int ch = 0; ch < PACK_CHANNELS; ch++) {
+        float a, q;
+        AdcChannelRing_AverageAll(&adc_singles[ch], &a);
+        Q10ChannelRing_AverageAll(&q10_singles[ch], &q);
+        if (a != avg_adc[ch] || q != avg_q10[ch]) int_mismatch++;
+    }
+    printf("Channel 0 avg: float %.4f V | int16 ADC %.2f counts | Q10 %.2f mV\n",
+           avg_pack[0], avg_adc[0], avg_q10[0] / 1024.0f);
+    printf("PackVoltRing vs 96 x RingBuffer (1000 ticks): %s\n", mc_mismatch == 0 ? "BIT-EXACT" : "MISMATCH!");
+    printf("PackAdcRing/PackQ10Ring vs 96 per-channel rings: %s\n", int_mismatch == 0 ? "BIT-EXACT" : "MISMATCH!");
+
+    printf("\n--- Benchmark: Push + Average All 96 Channels per Tick ---\n");
+    const int mc_ticks = 2000000;
+    float mc_acc = 0.0f;
+    double t0 = Bench_NowSec();
+    for (int tick = 0; tick < mc_ticks; tick++) {
+        frame[tick % PACK_CHANNELS] += 0.0001f;
+        for (int ch = 0; ch < PACK_CHANNELS; ch++) RB_AddSample(&singles[ch], frame[ch]);
+        for (int ch = 0; ch < PACK_CHANNELS; ch++) avg_single[ch] = RB_GetAverage(&singles[ch]);
+        mc_acc += avg_single[tick % PACK_CHANNELS];
+    }
+    double t_single = (Bench_NowSec() - t0) / mc_ticks;
+
+    t0 = Bench_NowSec();
+    for (int tick = 0; tick < mc_ticks; tick++) {
+        frame[tick % PACK_CHANNELS] += 0.0001f;
+        PackVoltRing_Push(&pack_ring, frame);
+        PackVoltRing_AverageAll(&pack_ring, avg_pack);
+        mc_acc += avg_pack[tick % PACK_CHANNELS];
+    }
+    double t_pack = (Bench_NowSec() - t0) / mc_ticks;
+
+    t0 = Bench_NowSec();
+    for (int tick = 0; tick < mc_ticks / 4; tick++) {
+        adc_frame[tick % PACK_CHANNELS]++;
+        PackAdcRing_Push(&adc_ring, adc_frame);
+        PackAdcRing_AverageAll(&adc_ring, avg_adc);
+        mc_acc += avg_adc[tick % PACK_CHANNELS];
+    }
+    double t_adc = (Bench_NowSec() - t0) / (mc_ticks / 4);
+
+    t0 = Bench_NowSec();
+    for (int tick = 0; tick < mc_ticks / 4; tick++) {
+        adc_frame[tick % PACK_CHANNELS]++;
+        for (int ch = 0; ch < PACK_CHANNELS; ch++) AdcChannelRing_Push(&adc_singles[ch], &adc_frame[ch]);
+        for (int ch = 0; ch < PACK_CHANNELS; ch++) AdcChannelRing_AverageAll(&adc_singles[ch], &avg_adc[ch]);
+        mc_acc += avg_adc[tick % PACK_CHANNELS];
+    }
+    double t_adc_single = (Bench_NowSec() - t0) / (mc_ticks / 4);
+
+    t0 = Bench_NowSec();
+    for (int tick = 0; tick < mc_ticks / 2; tick++) {
+        q10_frame[tick % PACK_CHANNELS] += 3;
+        PackQ10Ring_Push(&q10_ring, q10_frame);
+        PackQ10Ring_AverageAll(&q10_ring, avg_q10);
+        mc_acc += avg_q10[tick % PACK_CHANNELS];
+    }
+    double t_q10 = (Bench_NowSec() - t0) / (mc_ticks / 2);
+
+    t0 = Bench_NowSec();
+    for (int tick = 0; tick < mc_ticks / 2; tick++) {
+        q10_frame[tick % PACK_CHANNELS] += 3;
+        for (int ch = 0; ch < PACK_CHANNELS; ch++) Q10ChannelRing_Push(&q10_singles[ch], &q10_frame[ch]);
+        for (int ch = 0; ch < PACK_CHANNELS; ch++) Q10ChannelRing_AverageAll(&q10_singles[ch], &avg_q10[ch]);
+        mc_acc += avg_q10[tick % PACK_CHANNELS];
+    }
+    double t_q10_single = (Bench_NowSec() - t0) / (mc_ticks / 2);
+
+    printf("96 x RingBuffer (window 8):   %7.1f ns/tick\n", t_single * 1e9);
+    printf("PackVoltRing (float, 8):      %7.1f ns/tick (%.1fx)\n", t_pack * 1e9, t_single / t_pack);
+    printf("96 x AdcChannelRing (64):     %7.1f ns/tick\n", t_adc_single * 1e9);
+    printf("PackAdcRing (int16, 64):      %7.1f ns/tick (%.1fx)\n", t_adc * 1e9, t_adc_single / t_adc);
+    printf("96 x Q10ChannelRing (16):     %7.1f ns/tick\n", t_q10_single * 1e9);
+    printf("PackQ10Ring (Q10 int32, 16):  %7.1f ns/tick (%.1fx) [%.0f]\n", t_q10 * 1e9, t_q10_single / t_q10, mc_acc);
+
+    printf("\n--- Persistent Ring Buffer (mmap) ---\n");
+    char prb_path[] = "/tmp/prb_ring_XXXXXX";
+    int prb_fd = mkstemp(prb_path);
+    if (prb_fd < 0) {
+        printf("Could not create ring file in /tmp\n");
+        return 1;
+    }
+    close(prb_fd);
+
+    const uint32_t prb_cap = 1u << 20; // 4 MB of samples
+    static float prb_window[1u << 20];
+    PersistentRB prb;
+    bool prb_recovered;
+
+    // 1. Kill-and-recover: SIGKILL the writer at random points, 20 times
+    int prb_ok = 0;
+    uint64_t prb_seq = 0;
+    uint32_t prb_seed = 777;
+    for (int run = 0; run < 20; run++) {
+        prb_seed = prb_seed * 1103515245u + 12345u;
+        unsigned delay_us = 2000 + (prb_seed >> 16) % 20000;
+        if (PRB_KillAndRecover(prb_path, prb_cap, delay_us, prb_window, &prb_seq)) prb_ok++;
+    }
+    printf("Kill-and-recover: %d/20 runs recovered a consistent window (last seq %llu)\n",
+           prb_ok, (unsigned long long)prb_seq);
+
+    // 1b. Refuse, never wipe: opening the crash file with another capacity fails
+    //     and leaves it intact; so does a foreign file
+    uint32_t check_n;
+    uint64_t check_s;
+    bool refuse_ok = !PRB_Open(&prb, prb_path, prb_cap / 2, &prb_recovered) &&
+                     PRB_Recover(prb_path, prb_window, prb_cap, &check_n, &check_s) && check_s == prb_seq;
+    char foreign_path[] = "/tmp/prb_foreign_XXXXXX";
+    int foreign_fd = mkstemp(foreign_path);
+    if (foreign_fd >= 0) {
+        refuse_ok = refuse_ok && write(foreign_fd, "not a ring", 10) == 10;
+        close(foreign_fd);
+        refuse_ok = refuse_ok && !PRB_Open(&prb, foreign_path, prb_cap, &prb_recovered);
+        struct stat foreign_st;
+        refuse_ok = refuse_ok && stat(foreign_path, &foreign_st) == 0 && foreign_st.st_size == 10;
+        remove(foreign_path);
+    }
+    printf("Open with wrong capacity / foreign file: %s\n", refuse_ok ? "refused, data intact" : "FAIL!");
+
+    // 1c. Recover from a live writer: every window must be consecutive samples
+    //     ending at the reported seq, even when the writer laps the copy
+    {
+        const uint32_t live_cap = 1u << 16;
+        char live_path[] = "/tmp/prb_live_XXXXXX";
+        int live_fd = mkstemp(live_path);
+        if (live_fd >= 0) close(live_fd);
+        PersistentRB live;
+        if (live_fd < 0 || !PRB_Open(&live, live_path, live_cap, &prb_recovered)) {
+            printf("Could not create live ring file\n");
+            return 1;
+        }
+        PRB_Close(&live);
+        pid_t pid = fork();
+        if (pid == 0) {
+            if (!PRB_Open(&live, live_path, live_cap, &prb_recovered)) _exit(1);
+            for (;;) PRB_Append(&live, PRB_TestValue(live.seq));
+        }
+        uint32_t windows = 0, bad = 0, trimmed = 0;
+        double t_end = Bench_NowSec() + 0.3;
+        while (pid > 0 && Bench_NowSec() < t_end) {
+            uint32_t n;
+            uint64_t s;
+            if (!PRB_Recover(live_path, prb_window, live_cap, &n, &s)) continue;
+            windows++;
+            trimmed += (s >= live_cap && n < live_cap - 1);
+            for (uint32_t i = 0; i < n; i++)
+                if (prb_window[i] != PRB_TestValue(s - n + i)) {
+                    bad++;
+                    break;
+                }
+        }
+        if (pid > 0) {
+            kill(pid, SIGKILL);
+            waitpid(pid, NULL, 0);
+        }
+        remove(live_path);
+        printf("Live recover: %u windows, %u trimmed after a lap, %s\n", windows, trimmed,
+               (pid > 0 && windows > 0 && bad == 0) ? "all consistent" : "TORN!");
+    }
+
+    // 2. Reopen for writing: appending continues after the last published sample
+    if (!PRB_Open(&prb, prb_path, prb_cap, &prb_recovered)) {
+        printf("Could not open ring file\n");
+        return 1;
+    }
+    printf("Reopen: %s, seq %llu (expect %llu)\n", prb_recovered ? "recovered" : "FRESH!",
+           (unsigned long long)prb.seq, (unsigned long long)prb_seq);
+
+    // 3. Sustained writes, without and with periodic msync
+    const uint64_t prb_total = 200000000ull;
+    t0 = Bench_NowSec();
+    for (uint64_t i = 0; i < prb_total; i++) PRB_Append(&prb, (float)(i & 1023));
+    double t_plain = Bench_NowSec() - t0;
+
+    t0 = Bench_NowSec();
+    for (uint64_t i = 0; i < prb_total / 4; i++) {
+        PRB_Append(&prb, (float)(i & 1023));
+        if ((i & 0xFFFFF) == 0xFFFFF) PRB_Sync(&prb, false);
+    }
+    double t_async = Bench_NowSec() - t0;
+
+    t0 = Bench_NowSec();
+    for (uint64_t i = 0; i < prb_total / 20; i++) {
+        PRB_Append(&prb, (float)(i & 1023));
+        if ((i & 0xFFFFF) == 0xFFFFF) PRB_Sync(&prb, true);
+    }
+    double t_sync = Bench_NowSec() - t0;
+
+    // 4. Cost of one msync after the whole 4 MB window was rewritten
+    double t_ms_async = 0.0, t_ms_sync = 0.0;
+    for (int rep = 0; rep < 10; rep++) {
+        for (uint32_t i = 0; i < prb_cap; i++) PRB_Append(&prb, (float)i);
+        t0 = Bench_NowSec();
+        PRB_Sync(&prb, false);
+        t_ms_async += Bench_NowSec() - t0;
+        for (uint32_t i = 0; i < prb_cap; i++) PRB_Append(&prb, (float)i);
+        t0 = Bench_NowSec();
+        PRB_Sync(&prb, true);
+        t_ms_sync += Bench_NowSec() - t0;
+    }
+    PRB_Close(&prb);
+
+    printf("Appends, no msync:               %7.1f M samples/s\n", prb_total / t_plain / 1e6);
+    printf("Appends, MS_ASYNC every 1M:      %7.1f M samples/s\n", prb_total / 4 / t_async / 1e6);
+    printf("Appends, MS_SYNC every 1M:       %7.1f M samples/s\n", prb_total / 20 / t_sync / 1e6);
+    printf("msync of 4 MB dirty window:      MS_ASYNC %.3f ms | MS_SYNC %.3f ms\n",
+           t_ms_async / 10 * 1e3, t_ms_sync / 10 * 1e3);
+
+    PRB_RecoverTool(prb_path);
+    remove(prb_path);
+
     return 0;
 }
\ No newline at end of file
@@ -1,5 +1,13 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 // Simulated OCV Table (simplified LFP curve)
 // Voltage must be strictly increasing for this logic to work.
@@ -45,6 +53,676 @@ float GetSOC_From_Voltage(float voltage) {
     return 0.0f; // Should not reach here if bounds are handled
 }
 
+// Generic form of GetSOC_From_Voltage() for any table: the baseline the
+// preprocessed engine is checked and benchmarked against.
+float Interp_Scan(const float *x, const float *y, int n, float v) {
+    if (v <= x[0]) return y[0];
+    if (v >= x[n - 1]) return y[n - 1];
+    for (int i = 0; i < n - 1; i++) {
+        if (v >= x[i] && v <= x[i + 1]) {
+            return y[i] + ((v - x[i]) / (x[i + 1] - x[i])) * (y[i + 1] - y[i]);
+        }
+    }
+    return 0.0f;
+}
+
+// Task 2: Interpolation Engine (Preprocessed Tables)
+// GetSOC_From_Voltage() scans the table and divides on every call. Real OCV
+// tables have 200-1000 breakpoints and run for every cell every cycle, so
+// Interp_Build() does the expensive work once:
+//   - slope[i] = (y[i+1] - y[i]) / (x[i+1] - x[i]), so lookups only multiply.
+//   - INTERP_BINARY: branchless binary search (CMOV), log2(n) steps. Works for
+//     any table.
+//   - INTERP_GRID: split [x0, x_last] into equal cells. cell_seg[c] is the
+//     first segment that can hold a value in cell c. One multiply finds the cell
+//     and one compare finds the segment, so the cost is O(1) for any table size.
+// The engine picks the strategy per table. It uses the grid when no cell
+// overlaps more than 2 segments (so one compare is enough) and the grid needs at
+// most INTERP_GRID_MAX_RATIO cells per segment. Otherwise it uses binary search.
+// The rule is deterministic: the same table always gets the same code path.
+
+#define INTERP_GRID_MAX_RATIO 4
+
+typedef enum { INTERP_BINARY = 0, INTERP_GRID = 1 } Interp_Strategy;
+
+typedef struct {
+    int n;                      // Breakpoints
+    float *x, *y;               // Private copies of the table
+    float *slope;               // slope[i] for segment [x[i], x[i+1]]; slope[n-1] = 0 pad
+    Interp_Strategy strategy;
+    float grid_x0;
+    float grid_inv_step;        // Cells per volt
+    int grid_cells;
+    uint32_t *cell_seg;         // First candidate segment per cell (grid only)
+    int max_span;               // Most segments any grid cell overlaps
+} Interp_Table;
+
+// Cell of a value. Build and lookup use this same monotonic float expression,
+// so a value can never land in a cell whose segment range misses it.
+static inline int Interp_Cell(const Interp_Table *t, float v) {
+    int c = (int)((v - t->grid_x0) * t->grid_inv_step);
+    if (c < 0) c = 0;
+    if (c >= t->grid_cells) c = t->grid_cells - 1;
+    return c;
+}
+
+void Interp_Free(Interp_Table *t) {
+    free(t->x);
+    free(t->y);
+    free(t->slope);
+    free(t->cell_seg);
+    memset(t, 0, sizeof(*t));
+}
+
+bool Interp_Build(Interp_Table *t, const float *x, const float *y, int n) {
+    memset(t, 0, sizeof(*t));
+    if (n < 2) return false;
+    float min_dx = x[1] - x[0];
+    for (int i = 0; i < n - 1; i++) {
+        float dx = x[i + 1] - x[i];
+        if (!(dx > 0.0f)) return false; // Breakpoints must be strictly increasing
+        if (dx < min_dx) min_dx = dx;
+    }
+
+    t->n = n;
+    t->x = malloc((size_t)n * sizeof(float));
+    t->y = malloc((size_t)n * sizeof(float));
+    t->slope = malloc((size_t)n * sizeof(float));
+    if (t->x == NULL || t->y == NULL || t->slope == NULL) {
+        Interp_Free(t);
+        return false;
+    }
+    memcpy(t->x, x, (size_t)n * sizeof(float));
+    memcpy(t->y, y, (size_t)n * sizeof(float));
+    for (int i = 0; i < n - 1; i++) t->slope[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+    t->slope[n - 1] = 0.0f; // Lets SIMD gathers for clamped lanes stay in bounds
+
+    // Grid: about one cell per narrowest segment, capped relative to n
+    double range = (double)x[n - 1] - (double)x[0];
+    double cells = range / min_dx + 1.0;
+    if (cells > (double)INTERP_GRID_MAX_RATIO * (n - 1)) cells = (double)INTERP_GRID_MAX_RATIO * (n - 1);
+    t->grid_cells = (int)cells;
+    t->grid_x0 = x[0];
+    t->grid_inv_step = (float)(t->grid_cells / range);
+    t->cell_seg = malloc((size_t)t->grid_cells * sizeof(uint32_t));
+    if (t->cell_seg == NULL) {
+        Interp_Free(t);
+        return false;
+    }
+
+    // cell_seg[c] = last segment starting in an earlier cell (it may extend into c).
+    // Segments that start inside c follow it, and max_span counts them.
+    int lo = 0, hi = 0;
+    for (int c = 0; c < t->grid_cells; c++) {
+        while (lo + 1 <= n - 2 && Interp_Cell(t, x[lo + 1]) < c) lo++;
+        if (hi < lo) hi = lo;
+        while (hi + 1 <= n - 2 && Interp_Cell(t, x[hi + 1]) <= c) hi++;
+        t->cell_seg[c] = (uint32_t)lo;
+        if (hi - lo + 1 > t->max_span) t->max_span = hi - lo + 1;
+    }
+
+    if (t->max_span <= 2) {
+        t->strategy = INTERP_GRID;
+    } else {
+        t->strategy = INTERP_BINARY;
+        free(t->cell_seg);
+        t->cell_seg = NULL;
+    }
+    return true;
+}
+
+static inline float Interp_Segment(const Interp_Table *t, int i, float v) {
+    return t->y[i] + (v - t->x[i]) * t->slope[i];
+}
+
+// Segment search for x[0] <= v < x[n-1] (callers clamp first)
+static inline int Interp_Search_Binary(const Interp_Table *t, float v) {
+    const float *base = t->x;
+    int len = t->n - 1; // Search segment starts x[0 .. n-2]
+    while (len > 1) {
+        int half = len / 2;
+        base = (base[half] <= v) ? base + half : base; // CMOV, no branch
+        len -= half;
+    }
+    return (int)(base - t->x);
+}
+
+static inline int Interp_Search_Grid(const Interp_Table *t, float v) {
+    uint32_t i = t->cell_seg[Interp_Cell(t, v)];
+    i += (t->x[i + 1] <= v); // At most 2 candidate segments per cell
+    return (int)i;
+}
+
+static inline int Interp_Search(const Interp_Table *t, float v) {
+    return (t->strategy == INTERP_GRID) ? Interp_Search_Grid(t, v) : Interp_Search_Binary(t, v);
+}
+
+// Both lookups clamp exactly like GetSOC_From_Voltage()
+static inline float Interp_Lookup_Binary(const Interp_Table *t, float v) {
+    if (v <= t->x[0]) return t->y[0];
+    if (v >= t->x[t->n - 1]) return t->y[t->n - 1];
+    return Interp_Segment(t, Interp_Search_Binary(t, v), v);
+}
+
+static inline float Interp_Lookup_Grid(const Interp_Table *t, float v) {
+    if (v <= t->x[0]) return t->y[0];
+    if (v >= t->x[t->n - 1]) return t->y[t->n - 1];
+    return Interp_Segment(t, Interp_Search_Grid(t, v), v);
+}
+
+static inline float Interp_Lookup(const Interp_Table *t, float v) {
+    return (t->strategy == INTERP_GRID) ? Interp_Lookup_Grid(t, v) : Interp_Lookup_Binary(t, v);
+}
+
+// Task 3: Batch Interpolation (All Cells in a Pack)
+// Calling GetSOC_From_Voltage() once per cell leaves the SIMD units idle.
+// Interp_Lookup_Batch() takes the whole pack. The AVX2 version runs 8 cells per
+// instruction and uses gathers to fetch each lane's table entries:
+//   - GRID:   cell index (cvttps), then gathers for cell_seg and x[i+1], then one
+//             compare/subtract to step into the next segment.
+//   - BINARY: every lane does the same number of halving steps, so the branchless
+//             search vectorizes unchanged: one gather + compare + blend per step.
+// Four independent 8-lane groups are searched together. A lone gather chain
+// is latency bound; interleaving the groups keeps the load ports busy.
+// The segment formula uses a separate mul and add (no FMA) and clamps with the
+// same <= / >= tests, so every lane is bit-identical to Interp_Lookup().
+
+typedef void (*Interp_BatchFn)(const Interp_Table *t, const float *v, float *out, size_t n);
+
+void Interp_Lookup_Batch_Scalar(const Interp_Table *t, const float *v, float *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = Interp_Lookup(t, v[i]);
+}
+
+#if defined(__x86_64__)
+#define INTERP_AVX2_GROUP 4 // Independent 8-lane searches in flight: hides gather latency
+
+// Segment index for 'groups' vectors of queries. The groups do not depend on each
+// other, so their gather chains overlap in the out-of-order core.
+__attribute__((target("avx2")))
+static inline void Interp_Avx2_Search(const Interp_Table *t, const __m256 *q, __m256i *seg, int groups) {
+    const __m256i zero = _mm256_setzero_si256();
+    if (t->strategy == INTERP_GRID) {
+        const __m256 grid_x0 = _mm256_set1_ps(t->grid_x0), grid_inv = _mm256_set1_ps(t->grid_inv_step);
+        const __m256i cell_max = _mm256_set1_epi32(t->grid_cells - 1);
+        for (int k = 0; k < groups; k++) {
+            __m256i c = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(q[k], grid_x0), grid_inv));
+            c = _mm256_min_epi32(_mm256_max_epi32(c, zero), cell_max);
+            seg[k] = _mm256_i32gather_epi32((const int *)t->cell_seg, c, 4);
+        }
+        for (int k = 0; k < groups; k++) {
+            __m256 x_next = _mm256_i32gather_ps(t->x + 1, seg[k], 4);
+            seg[k] = _mm256_sub_epi32(seg[k], _mm256_castps_si256(_mm256_cmp_ps(x_next, q[k], _CMP_LE_OQ))); // +1 where true
+        }
+    } else {
+        for (int k = 0; k < groups; k++) seg[k] = zero;
+        int len = t->n - 1;
+        while (len > 1) {
+            int half = len / 2;
+            for (int k = 0; k < groups; k++) {
+                __m256i probe = _mm256_add_epi32(seg[k], _mm256_set1_epi32(half));
+                __m256 x_probe = _mm256_i32gather_ps(t->x, probe, 4);
+                seg[k] = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(seg[k]), _mm256_castsi256_ps(probe),
+                                                              _mm256_cmp_ps(x_probe, q[k], _CMP_LE_OQ)));
+            }
+            len -= half;
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static inline __m256 Interp_Avx2_Eval(const Interp_Table *t, __m256 q, __m256i seg) {
+    __m256 xi = _mm256_i32gather_ps(t->x, seg, 4);
+    __m256 yi = _mm256_i32gather_ps(t->y, seg, 4);
+    __m256 si = _mm256_i32gather_ps(t->slope, seg, 4);
+    __m256 r = _mm256_add_ps(yi, _mm256_mul_ps(_mm256_sub_ps(q, xi), si));
+    r = _mm256_blendv_ps(r, _mm256_set1_ps(t->y[t->n - 1]), _mm256_cmp_ps(q, _mm256_set1_ps(t->x[t->n - 1]), _CMP_GE_OQ));
+    r = _mm256_blendv_ps(r, _mm256_set1_ps(t->y[0]), _mm256_cmp_ps(q, _mm256_set1_ps(t->x[0]), _CMP_LE_OQ));
+    return r;
+}
+
+__attribute__((target("avx2")))
+static void Interp_Lookup_Batch_Avx2(const Interp_Table *t, const float *v, float *out, size_t n) {
+    __m256 q[INTERP_AVX2_GROUP];
+    __m256i seg[INTERP_AVX2_GROUP];
+    size_t i = 0;
+
+    for (; i + 8 * INTERP_AVX2_GROUP <= n; i += 8 * INTERP_AVX2_GROUP) {
+        for (int k = 0; k < INTERP_AVX2_GROUP; k++) q[k] = _mm256_loadu_ps(v + i + 8 * k);
+        Interp_Avx2_Search(t, q, seg, INTERP_AVX2_GROUP);
+        for (int k = 0; k < INTERP_AVX2_GROUP; k++) _mm256_storeu_ps(out + i + 8 * k, Interp_Avx2_Eval(t, q[k], seg[k]));
+    }
+    for (; i + 8 <= n; i += 8) {
+        q[0] = _mm256_loadu_ps(v + i);
+        Interp_Avx2_Search(t, q, seg, 1);
+        _mm256_storeu_ps(out + i, Interp_Avx2_Eval(t, q[0], seg[0]));
+    }
+    for (; i < n; i++) out[i] = Interp_Lookup(t, v[i]); // Inlined: stays VEX-encoded, no AVX/SSE switch
+}
+#endif
+
+Interp_BatchFn Interp_Lookup_Batch = Interp_Lookup_Batch_Scalar;
+const char *interp_batch_impl = "Scalar";
+
+void Interp_Batch_Init(void) {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        Interp_Lookup_Batch = Interp_Lookup_Batch_Avx2;
+        interp_batch_impl = "AVX2";
+    }
+#endif
+}
+
+// Task 4: 2D/3D Lookup Tables (Voltage x Temperature x Current)
+// OCV and internal-resistance maps also depend on temperature and current.
+// Interp_ND interpolates over up to 3 axes and reuses the 1D engine:
+//   - Each axis is an Interp_Table with y[i] = i. Interp_Search() finds the
+//     segment (grid or binary), and slope[i] is then exactly 1 / dx, so the
+//     fraction inside a segment costs one multiply.
+//   - Values are one contiguous row-major block with the last axis innermost.
+//     Neighbours along that axis share a cache line, so put the axis with the
+//     most breakpoints (voltage) last.
+//   - Interp_ND_Cursor remembers the segment per axis from the previous call.
+//     A cell's voltage and temperature barely move between cycles, so the
+//     cursor usually hits and the search is skipped (one compare pair per axis).
+//   - Optional fixed-point path (Interp_ND_BuildFixed): integer breakpoints and
+//     values, Q16 fractions from precomputed reciprocals. No FPU needed.
+
+#define INTERP_MAX_DIMS 3
+
+typedef struct {
+    uint32_t seg[INTERP_MAX_DIMS]; // Segment used by the previous lookup
+} Interp_ND_Cursor;
+
+typedef struct {
+    int dims;
+    int n[INTERP_MAX_DIMS];         // Breakpoints per axis
+    int stride[INTERP_MAX_DIMS];    // Values between neighbours along an axis
+    Interp_Table axis[INTERP_MAX_DIMS];
+    float *values;                  // Row-major, last axis contiguous
+    // Fixed-point path
+    bool has_fixed;
+    int32_t *xq[INTERP_MAX_DIMS];   // Breakpoints * axis_scale
+    uint32_t *inv_q[INTERP_MAX_DIMS]; // 2^32 / dx_q: fraction = (q - xq) * inv >> 16
+    int32_t *values_q;              // Values * value_scale
+} Interp_ND;
+
+void Interp_ND_Free(Interp_ND *t) {
+    for (int d = 0; d < INTERP_MAX_DIMS; d++) {
+        Interp_Free(&t->axis[d]);
+        free(t->xq[d]);
+        free(t->inv_q[d]);
+    }
+    free(t->values);
+    free(t->values_q);
+    memset(t, 0, sizeof(*t));
+}
+
+// breakpoints[d] has n[d] strictly increasing entries; values holds
+// n[0] * n[1] * n[2] entries, last axis fastest.
+bool Interp_ND_Build(Interp_ND *t, int dims, const int *n, const float *const *breakpoints, const float *values) {
+    memset(t, 0, sizeof(*t));
+    if (dims < 1 || dims > INTERP_MAX_DIMS) return false;
+    t->dims = dims;
+    size_t count = 1;
+    for (int d = dims - 1; d >= 0; d--) {
+        t->n[d] = n[d];
+        t->stride[d] = (int)count;
+        count *= (size_t)n[d];
+
+        float *index = malloc((size_t)n[d] * sizeof(float));
+        if (index == NULL) {
+            Interp_ND_Free(t);
+            return false;
+        }
+        for (int i = 0; i < n[d]; i++) index[i] = (float)i;
+        bool ok = Interp_Build(&t->axis[d], breakpoints[d], index, n[d]);
+        free(index);
+        if (!ok) {
+            Interp_ND_Free(t);
+            return false;
+        }
+    }
+    t->values = malloc(count * sizeof(float));
+    if (t->values == NULL) {
+        Interp_ND_Free(t);
+        return false;
+    }
+    memcpy(t->values, values, count * sizeof(float));
+    return true;
+}
+
+static int32_t Interp_RoundQ(float v) {
+    return (int32_t)(v >= 0.0f ? v + 0.5f : v - 0.5f);
+}
+
+// Optional integer path. axis_scale[d] converts axis units to integer query
+// units (e.g. 1000 for mV); value_scale converts the output (e.g. 100 for 0.01 %).
+bool Interp_ND_BuildFixed(Interp_ND *t, const float *axis_scale, float value_scale) {
+    size_t count = (size_t)t->stride[0] * t->n[0];
+    for (int d = 0; d < t->dims; d++) {
+        int n = t->n[d];
+        t->xq[d] = malloc((size_t)n * sizeof(int32_t));
+        t->inv_q[d] = malloc((size_t)n * sizeof(uint32_t));
+        if (t->xq[d] == NULL || t->inv_q[d] == NULL) return false;
+        for (int i = 0; i < n; i++) t->xq[d][i] = Interp_RoundQ(t->axis[d].x[i] * axis_scale[d]);
+        for (int i = 0; i < n - 1; i++) {
+            int64_t dx = (int64_t)t->xq[d][i + 1] - t->xq[d][i];
+            if (dx <= 0) return false; // Breakpoints collapsed at this scale
+            t->inv_q[d][i] = (uint32_t)((1ull << 32) / (uint64_t)dx);
+        }
+        t->inv_q[d][n - 1] = 0;
+    }
+    t->values_q = malloc(count * sizeof(int32_t));
+    if (t->values_q == NULL) return false;
+    for (size_t i = 0; i < count; i++) t->values_q[i] = Interp_RoundQ(t->values[i] * value_scale);
+    t->has_fixed = true;
+    return true;
+}
+
+// Segment and fraction along one axis. Clamps like GetSOC_From_Voltage().
+static inline int Interp_ND_Axis(const Interp_Table *a, float v, uint32_t *hint, float *frac) {
+    if (v <= a->x[0]) {
+        *frac = 0.0f;
+        return 0;
+    }
+    if (v >= a->x[a->n - 1]) {
+        *frac = 1.0f;
+        return a->n - 2;
+    }
+    int i = (int)*hint;
+    if (!(a->x[i] <= v && v < a->x[i + 1])) { // Cursor miss: full search
+        i = Interp_Search(a, v);
+        *hint = (uint32_t)i;
+    }
+    *frac = (v - a->x[i]) * a->slope[i];
+    return i;
+}
+
+static inline float Interp_Lerp(float a, float b, float f) {
+    return a + (b - a) * f;
+}
+
+// q[d] is the query along axis d. cur may be NULL (no caching).
+static inline float Interp_ND_Lookup(const Interp_ND *t, const float *q, Interp_ND_Cursor *cur) {
+    Interp_ND_Cursor scratch = { { 0, 0, 0 } };
+    if (cur == NULL) cur = &scratch;
+    float f[INTERP_MAX_DIMS];
+    size_t base = 0;
+    for (int d = 0; d < t->dims; d++) {
+        base += (size_t)Interp_ND_Axis(&t->axis[d], q[d], &cur->seg[d], &f[d]) * t->stride[d];
+    }
+    const float *p = t->values + base;
+
+    // Collapse one axis at a time, innermost (contiguous) first
+    if (t->dims == 1) return Interp_Lerp(p[0], p[1], f[0]);
+    int s0 = t->stride[0];
+    if (t->dims == 2) {
+        float lo = Interp_Lerp(p[0], p[1], f[1]);
+        float hi = Interp_Lerp(p[s0], p[s0 + 1], f[1]);
+        return Interp_Lerp(lo, hi, f[0]);
+    }
+    int s1 = t->stride[1];
+    float c00 = Interp_Lerp(p[0], p[1], f[2]);
+    float c01 = Interp_Lerp(p[s1], p[s1 + 1], f[2]);
+    float c10 = Interp_Lerp(p[s0], p[s0 + 1], f[2]);
+    float c11 = Interp_Lerp(p[s0 + s1], p[s0 + s1 + 1], f[2]);
+    return Interp_Lerp(Interp_Lerp(c00, c01, f[1]), Interp_Lerp(c10, c11, f[1]), f[0]);
+}
+
+// --- Fixed-point path: q[d] in axis units * axis_scale[d] ---
+static inline int Interp_ND_AxisFixed(const Interp_ND *t, int d, int32_t v, uint32_t *hint, int32_t *frac) {
+    const int32_t *x = t->xq[d];
+    int n = t->n[d];
+    if (v <= x[0]) {
+        *frac = 0;
+        return 0;
+    }
+    if (v >= x[n - 1]) {
+        *frac = 1 << 16;
+        return n - 2;
+    }
+    int i = (int)*hint;
+    if (!(x[i] <= v && v < x[i + 1])) {
+        const int32_t *base = x;
+        int len = n - 1;
+        while (len > 1) {
+            int half = len / 2;
+            base = (base[half] <= v) ? base + half : base;
+            len -= half;
+        }
+        i = (int)(base - x);
+        *hint = (uint32_t)i;
+    }
+    *frac = (int32_t)(((uint64_t)(uint32_t)(v - x[i]) * t->inv_q[d][i]) >> 16); // Q16, [0, 65536)
+    return i;
+}
+
+static inline int32_t Interp_LerpQ16(int32_t a, int32_t b, int32_t f) {
+    return a + (int32_t)(((int64_t)(b - a) * f) >> 16);
+}
+
+static inline int32_t Interp_ND_LookupFixed(const Interp_ND *t, const int32_t *q, Interp_ND_Cursor *cur) {
+    Interp_ND_Cursor scratch = { { 0, 0, 0 } };
+    if (cur == NULL) cur = &scratch;
+    int32_t f[INTERP_MAX_DIMS];
+    size_t base = 0;
+    for (int d = 0; d < t->dims; d++) {
+        base += (size_t)Interp_ND_AxisFixed(t, d, q[d], &cur->seg[d], &f[d]) * t->stride[d];
+    }
+    const int32_t *p = t->values_q + base;
+
+    if (t->dims == 1) return Interp_LerpQ16(p[0], p[1], f[0]);
+    int s0 = t->stride[0];
+    if (t->dims == 2) {
+        int32_t lo = Interp_LerpQ16(p[0], p[1], f[1]);
+        int32_t hi = Interp_LerpQ16(p[s0], p[s0 + 1], f[1]);
+        return Interp_LerpQ16(lo, hi, f[0]);
+    }
+    int s1 = t->stride[1];
+    int32_t c00 = Interp_LerpQ16(p[0], p[1], f[2]);
+    int32_t c01 = Interp_LerpQ16(p[s1], p[s1 + 1], f[2]);
+    int32_t c10 = Interp_LerpQ16(p[s0], p[s0 + 1], f[2]);
+    int32_t c11 = Interp_LerpQ16(p[s0 + s1], p[s0 + s1 + 1], f[2]);
+    return Interp_LerpQ16(Interp_LerpQ16(c00, c01, f[1]), Interp_LerpQ16(c10, c11, f[1]), f[0]);
+}
+
+// Baseline: GetSOC_From_Voltage()-style scan and divide per axis, then a
+// nested loop over all 2^dims corners with per-corner weights.
+float Interp_ND_Naive(const Interp_ND *t, const float *q) {
+    int seg[INTERP_MAX_DIMS];
+    float f[INTERP_MAX_DIMS];
+    for (int d = 0; d < t->dims; d++) {
+        const float *x = t->axis[d].x;
+        int n = t->n[d];
+        float v = q[d];
+        if (v <= x[0]) v = x[0];
+        if (v >= x[n - 1]) v = x[n - 1];
+        for (int i = 0; i < n - 1; i++) {
+            if (v >= x[i] && v <= x[i + 1]) {
+                seg[d] = i;
+                f[d] = (v - x[i]) / (x[i + 1] - x[i]);
+                break;
+            }
+        }
+    }
+    float sum = 0.0f;
+    for (int corner = 0; corner < (1 << t->dims); corner++) {
+        float w = 1.0f;
+        size_t idx = 0;
+        for (int d = 0; d < t->dims; d++) {
+            int bit = (corner >> (t->dims - 1 - d)) & 1;
+            w *= bit ? f[d] : 1.0f - f[d];
+            idx += (size_t)(seg[d] + bit) * t->stride[d];
+        }
+        sum += w * t->values[idx];
+    }
+    return sum;
+}
+
+// Task 5: Monotone Cubic (PCHIP) Interpolation
+// The LFP curve bends sharply around the 3.20-3.30 V plateau. Straight lines
+// need many breakpoints to follow it, and more points make lookups slower.
+// PCHIP (Fritsch-Carlson) fits one cubic per segment:
+//   - Slopes at the breakpoints are weighted harmonic means of the neighbouring
+//     secant slopes, and 0 at a local extremum. The curve never overshoots and
+//     stays monotone wherever the data is, so SOC can never run backwards.
+//   - Interp_Pchip_Build() precomputes the 4 coefficients of every segment once.
+//     A lookup is the usual segment search plus a 3-multiply Horner evaluation:
+//         y = c0 + t * (c1 + t * (c2 + t * c3)),  t = v - x[i]
+// The coefficients of a segment are stored together (16 bytes), so the whole
+// evaluation touches one cache line.
+
+typedef struct {
+    Interp_Table search;        // Breakpoints, strategy and clamping values
+    float (*coef)[4];           // c0..c3 per segment
+} Interp_Pchip;
+
+void Interp_Pchip_Free(Interp_Pchip *p) {
+    Interp_Free(&p->search);
+    free(p->coef);
+    p->coef = NULL;
+}
+
+// End-point slope: non-centered three-point formula, kept shape-preserving
+static double Pchip_EndSlope(double h0, double h1, double m0, double m1) {
+    double d = ((2.0 * h0 + h1) * m0 - h0 * m1) / (h0 + h1);
+    if ((d > 0.0) != (m0 > 0.0)) return 0.0;
+    if ((m0 > 0.0) != (m1 > 0.0) && fabs(d) > fabs(3.0 * m0)) return 3.0 * m0;
+    return d;
+}
+
+bool Interp_Pchip_Build(Interp_Pchip *p, const float *x, const float *y, int n) {
+    p->coef = NULL;
+    if (!Interp_Build(&p->search, x, y, n)) return false;
+    p->coef = malloc((size_t)(n - 1) * sizeof(p->coef[0]));
+    double *h = malloc((size_t)(n - 1) * sizeof(double));
+    double *m = malloc((size_t)(n - 1) * sizeof(double));
+    double *d = malloc((size_t)n * sizeof(double));
+    if (p->coef == NULL || h == NULL || m == NULL || d == NULL) {
+        free(h);
+        free(m);
+        free(d);
+        Interp_Pchip_Free(p);
+        return false;
+    }
+
+    // Secants, then slopes at the breakpoints (double: the plateau has tiny dx)
+    for (int i = 0; i < n - 1; i++) {
+        h[i] = (double)x[i + 1] - x[i];
+        m[i] = ((double)y[i + 1] - y[i]) / h[i];
+    }
+    if (n == 2) {
+        d[0] = d[1] = m[0];
+    } else {
+        for (int i = 1; i < n - 1; i++) {
+            if (m[i - 1] * m[i] <= 0.0) {
+                d[i] = 0.0; // Local extremum or flat: keep it flat
+            } else {
+                double w1 = 2.0 * h[i] + h[i - 1], w2 = h[i] + 2.0 * h[i - 1];
+                d[i] = (w1 + w2) / (w1 / m[i - 1] + w2 / m[i]);
+            }
+        }
+        d[0] = Pchip_EndSlope(h[0], h[1], m[0], m[1]);
+        d[n - 1] = Pchip_EndSlope(h[n - 2], h[n - 3], m[n - 2], m[n - 3]);
+    }
+
+    // Hermite form -> power basis in t = v - x[i]
+    for (int i = 0; i < n - 1; i++) {
+        p->coef[i][0] = y[i];
+        p->coef[i][1] = (float)d[i];
+        p->coef[i][2] = (float)((3.0 * m[i] - 2.0 * d[i] - d[i + 1]) / h[i]);
+        p->coef[i][3] = (float)((d[i] + d[i + 1] - 2.0 * m[i]) / (h[i] * h[i]));
+    }
+    free(h);
+    free(m);
+    free(d);
+    return true;
+}
+
+// Clamps exactly like GetSOC_From_Voltage()
+static inline float Interp_Pchip_Lookup(const Interp_Pchip *p, float v) {
+    const Interp_Table *t = &p->search;
+    if (v <= t->x[0]) return t->y[0];
+    if (v >= t->x[t->n - 1]) return t->y[t->n - 1];
+    int i = Interp_Search(t, v);
+    const float *c = p->coef[i];
+    float dt = v - t->x[i];
+    return c[0] + dt * (c[1] + dt * (c[2] + dt * c[3]));
+}
+
+// --- Synthetic LFP OCV curve (benchmark tables) ---
+// Smooth and strictly increasing: a fast rise at low SOC, a flat plateau
+// (about 1.2 mV per % SOC), and a steep knee near full. No libm needed.
+double Ocv_Model_Voltage(double soc) {
+    double u = soc / 100.0;
+    double u2 = u * u, u4 = u2 * u2, u8 = u4 * u4, u16 = u8 * u8, u32 = u16 * u16;
+    return 2.90 + 0.30 * u / (u + 0.04) + 0.08 * u + 0.30 * u32;
+}
+
+// Inverse by bisection: the "true" SOC for a voltage inside the curve's range
+double Ocv_Model_Soc(double v) {
+    double lo = 0.0, hi = 100.0;
+    for (int i = 0; i < 60; i++) {
+        double mid = 0.5 * (lo + hi);
+        if (Ocv_Model_Voltage(mid) < v) lo = mid;
+        else hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+// Table with n breakpoints spaced evenly in voltage (grid-friendly) or in SOC
+// (how OCV tables are usually measured: dense in V on the plateau).
+void Ocv_Model_Table(float *x, float *y, int n, bool uniform_soc) {
+    double v0 = Ocv_Model_Voltage(0.0), v1 = Ocv_Model_Voltage(100.0);
+    for (int i = 0; i < n; i++) {
+        double f = (double)i / (n - 1);
+        double soc = uniform_soc ? 100.0 * f : Ocv_Model_Soc(v0 + (v1 - v0) * f);
+        x[i] = (float)Ocv_Model_Voltage(soc);
+        y[i] = (float)soc;
+    }
+}
+
+// --- Benchmark helpers ---
+static volatile float bench_sink;
+
+static double Bench_NowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Each loop inlines its lookup. Returns ns per lookup.
+static double Bench_Scan(const Interp_Table *t, const float *q, int nq, int reps) {
+    float acc = 0.0f;
+    double t0 = Bench_NowSec();
+    for (int r = 0; r < reps; r++)
+        for (int i = 0; i < nq; i++) acc += Interp_Scan(t->x, t->y, t->n, q[i]);
+    double dt = Bench_NowSec() - t0;
+    bench_sink = acc;
+    return dt / ((double)reps * nq) * 1e9;
+}
+
+static double Bench_Binary(const Interp_Table *t, const float *q, int nq, int reps) {
+    float acc = 0.0f;
+    double t0 = Bench_NowSec();
+    for (int r = 0; r < reps; r++)
+        for (int i = 0; i < nq; i++) acc += Interp_Lookup_Binary(t, q[i]);
+    double dt = Bench_NowSec() - t0;
+    bench_sink = acc;
+    return dt / ((double)reps * nq) * 1e9;
+}
+
+static double Bench_Grid(const Interp_Table *t, const float *q, int nq, int reps) {
+    float acc = 0.0f;
+    double t0 = Bench_NowSec();
+    for (int r = 0; r < reps; r++)
+        for (int i = 0; i < nq; i++) acc += Interp_Lookup_Grid(t, q[i]);
+    double dt = Bench_NowSec() - t0;
+    bench_sink = acc;
+    return dt / ((double)reps * nq) * 1e9;
+}
+
 int main() {
     // Test Cases
     float test_volts[] = { 2.9f, 3.0f, 3.1f, 3.225f, 3.6f, 3.7f };
@@ -62,5 +740,313 @@ int main() {
         printf("Voltage: %.3f V -> SOC: %.2f%%\n", v, soc);
     }
 
+    printf("\n--- Interpolation Engine: Same Test Cases ---\n");
+    Interp_Table lut;
+    Interp_Build(&lut, LUT_Voltage, LUT_SOC, TABLE_SIZE);
+    printf("LUT strategy: %s (%d grid cells, max %d segments/cell)\n",
+           lut.strategy == INTERP_GRID ? "GRID" : "BINARY", lut.grid_cells, lut.max_span);
+    for (int i = 0; i < 6; i++) {
+        float v = test_volts[i];
+        printf("Voltage: %.3f V -> Scan %.2f%% | Binary %.2f%% | Engine %.2f%%\n", v,
+               GetSOC_From_Voltage(v), Interp_Lookup_Binary(&lut, v), Interp_Lookup(&lut, v));
+    }
+    Interp_Free(&lut);
+
+    printf("\n--- Benchmark: ns/lookup (Random | Monotonic Queries) ---\n");
+    #define NUM_QUERIES 65536
+    static float q_random[NUM_QUERIES], q_ramp[NUM_QUERIES];
+    static float tab_x[4096], tab_y[4096];
+    const int sizes[] = { 5, 64, 200, 1000, 4096 };
+    double v_lo = Ocv_Model_Voltage(0.0) - 0.05, v_hi = Ocv_Model_Voltage(100.0) + 0.05;
+    srand(42);
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        q_random[i] = (float)(v_lo + (v_hi - v_lo) * rand() / RAND_MAX);
+        q_ramp[i] = (float)(v_lo + (v_hi - v_lo) * i / NUM_QUERIES); // Slow sweep: cache- and predictor-friendly
+    }
+    printf("%-11s %5s %-6s %9s %15s %15s %15s %9s\n", "Spacing", "N", "Pick", "MaxErr", "Scan", "Binary", "Grid", "Speedup");
+    for (int spacing = 0; spacing < 2; spacing++) {
+        for (int s = 0; s < 5; s++) {
+            int n = sizes[s];
+            Ocv_Model_Table(tab_x, tab_y, n, spacing == 1);
+            Interp_Table tab;
+            if (!Interp_Build(&tab, tab_x, tab_y, n)) return 1;
+
+            // Engine vs scan: only slope rounding may differ
+            float max_err = 0.0f;
+            for (int i = 0; i < NUM_QUERIES; i++) {
+                float e = fabsf(Interp_Lookup(&tab, q_random[i]) - Interp_Scan(tab_x, tab_y, n, q_random[i]));
+                if (e > max_err) max_err = e;
+            }
+
+            int reps_fast = 100, reps_scan = (n > 200) ? 1 : 20;
+            double scan_r = Bench_Scan(&tab, q_random, NUM_QUERIES, reps_scan);
+            double scan_m = Bench_Scan(&tab, q_ramp, NUM_QUERIES, reps_scan);
+            double bin_r = Bench_Binary(&tab, q_random, NUM_QUERIES, reps_fast);
+            double bin_m = Bench_Binary(&tab, q_ramp, NUM_QUERIES, reps_fast);
+            char grid_col[32] = "   (not used)";
+            double best_r = bin_r;
+            if (tab.strategy == INTERP_GRID) {
+                double grid_r = Bench_Grid(&tab, q_random, NUM_QUERIES, reps_fast);
+                double grid_m = Bench_Grid(&tab, q_ramp, NUM_QUERIES, reps_fast);
+                snprintf(grid_col, sizeof(grid_col), "%6.1f | %6.1f", grid_r, grid_m);
+                best_r = grid_r;
+            }
+            printf("%-11s %5d %-6s %9.2e %6.1f | %6.1f %6.1f | %6.1f %15s %8.1fx\n",
+                   spacing ? "uniform SOC" : "uniform V", n, tab.strategy == INTERP_GRID ? "GRID" : "BINARY",
+                   max_err, scan_r, scan_m, bin_r, bin_m, grid_col, scan_r / best_r);
+            Interp_Free(&tab);
+        }
+    }
+
+    Interp_Batch_Init();
+    printf("\n--- Batch Interpolation (%s) ---\n", interp_batch_impl);
+    Interp_Build(&lut, LUT_Voltage, LUT_SOC, TABLE_SIZE);
+    // Clamped inputs and breakpoints must match GetSOC_From_Voltage() exactly;
+    // every input must match the scalar engine bit for bit
+    float clamp_in[16] = { -INFINITY, 0.0f, 2.9f, 2.99999f, 3.0f, 3.2f, 3.25f, 3.3f,
+                           3.6f, 3.60001f, 3.7f, 100.0f, INFINITY, 3.1f, 3.225f, 3.59999f };
+    float clamp_out[16];
+    Interp_Lookup_Batch(&lut, clamp_in, clamp_out, 16);
+    int clamp_bad = 0, engine_bad = 0;
+    for (int i = 0; i < 16; i++) {
+        if (i < 13 && clamp_out[i] != GetSOC_From_Voltage(clamp_in[i])) clamp_bad++;
+        if (clamp_out[i] != Interp_Lookup(&lut, clamp_in[i])) engine_bad++;
+    }
+    printf("Clamping and breakpoints vs GetSOC_From_Voltage: %s\n", clamp_bad ? "MISMATCH!" : "IDENTICAL");
+    printf("All 16 inputs vs scalar Interp_Lookup:           %s\n", engine_bad ? "MISMATCH!" : "BIT-EXACT");
+    Interp_Free(&lut);
+
+    printf("\n--- Benchmark: M cells/s ---\n");
+    #define MAX_CELLS 1000000
+    static float cell_v[MAX_CELLS], cell_soc[MAX_CELLS], cell_ref[MAX_CELLS];
+    for (int i = 0; i < MAX_CELLS; i++) cell_v[i] = (float)(v_lo + (v_hi - v_lo) * rand() / RAND_MAX);
+    const size_t pack_sizes[] = { 96, 1000, MAX_CELLS };
+    printf("%-20s %8s %10s %10s %10s %9s %s\n", "Table", "Cells", "Scan", "Scalar", "Batch", "Speedup", "Check");
+    for (int spacing = 0; spacing < 2; spacing++) {
+        int n = spacing ? 1000 : 200;
+        Ocv_Model_Table(tab_x, tab_y, n, spacing == 1);
+        Interp_Table tab;
+        if (!Interp_Build(&tab, tab_x, tab_y, n)) return 1;
+        for (int p = 0; p < 3; p++) {
+            size_t cells = pack_sizes[p];
+            int reps = (int)(4000000 / cells) + 1;
+            int reps_scan = (cells == MAX_CELLS) ? 1 : reps / 20 + 1;
+            float acc = 0.0f;
+
+            double t0 = Bench_NowSec();
+            for (int r = 0; r < reps_scan; r++) {
+                for (size_t i = 0; i < cells; i++) cell_ref[i] = Interp_Scan(tab_x, tab_y, n, cell_v[i]);
+                acc += cell_ref[r % cells];
+            }
+            double t_scan = (Bench_NowSec() - t0) / reps_scan;
+
+            t0 = Bench_NowSec();
+            for (int r = 0; r < reps; r++) {
+                Interp_Lookup_Batch_Scalar(&tab, cell_v, cell_ref, cells);
+                acc += cell_ref[r % cells];
+            }
+            double t_scalar = (Bench_NowSec() - t0) / reps;
+
+            t0 = Bench_NowSec();
+            for (int r = 0; r < reps; r++) {
+                Interp_Lookup_Batch(&tab, cell_v, cell_soc, cells);
+                acc += cell_soc[r % cells];
+            }
+            double t_batch = (Bench_NowSec() - t0) / reps;
+            bench_sink = acc;
+
+            int diff = 0;
+            for (size_t i = 0; i < cells; i++) diff += (cell_soc[i] != cell_ref[i]);
+            char name[32];
+            snprintf(name, sizeof(name), "%d pts, %s", n, tab.strategy == INTERP_GRID ? "GRID" : "BINARY");
+            printf("%-20s %8zu %10.1f %10.1f %10.1f %8.1fx %s\n", name, cells, cells / t_scan / 1e6,
+                   cells / t_scalar / 1e6, cells / t_batch / 1e6, t_scalar / t_batch, diff ? "MISMATCH!" : "bit-exact");
+        }
+        Interp_Free(&tab);
+    }
+
+    printf("\n--- 2D/3D Tables (Current x Temperature x Voltage) ---\n");
+    // Synthetic SOC map: OCV curve seen through an IR drop that grows in the cold
+    #define ND_NV 200
+    #define ND_NT 12
+    #define ND_NI 10
+    static float ax_v[ND_NV], nd_values[ND_NI * ND_NT * ND_NV];
+    static const float ax_t[ND_NT] = { -20, -10, 0, 5, 10, 15, 20, 25, 30, 35, 45, 55 };
+    static const float ax_i[ND_NI] = { -100, -50, -20, -5, 0, 5, 20, 50, 100, 150 };
+    double ocv_min = Ocv_Model_Voltage(0.0), ocv_max = Ocv_Model_Voltage(100.0);
+    for (int i = 0; i < ND_NV; i++) ax_v[i] = (float)(ocv_min + (ocv_max - ocv_min) * i / (ND_NV - 1));
+    for (int ci = 0; ci < ND_NI; ci++) {
+        for (int ti = 0; ti < ND_NT; ti++) {
+            double r = 0.0015 * (1.0 + 0.04 * (25.0 - ax_t[ti]));
+            for (int vi = 0; vi < ND_NV; vi++) {
+                double ocv = ax_v[vi] + ax_i[ci] * r;
+                if (ocv < ocv_min) ocv = ocv_min;
+                if (ocv > ocv_max) ocv = ocv_max;
+                nd_values[(ci * ND_NT + ti) * ND_NV + vi] = (float)Ocv_Model_Soc(ocv);
+            }
+        }
+    }
+    const float *axes3[3] = { ax_i, ax_t, ax_v };
+    const int n3[3] = { ND_NI, ND_NT, ND_NV };
+    const float scale3[3] = { 1000.0f, 100.0f, 10000.0f }; // mA, 0.01 C, 0.1 mV
+    Interp_ND map2, map3;
+    // 2D: the I = 0 A slice, Temperature x Voltage
+    const float *axes2[2] = { ax_t, ax_v };
+    const int n2[2] = { ND_NT, ND_NV };
+    const float scale2[2] = { 100.0f, 10000.0f };
+    if (!Interp_ND_Build(&map2, 2, n2, axes2, nd_values + 4 * ND_NT * ND_NV) ||
+        !Interp_ND_Build(&map3, 3, n3, axes3, nd_values) ||
+        !Interp_ND_BuildFixed(&map2, scale2, 100.0f) || !Interp_ND_BuildFixed(&map3, scale3, 100.0f)) {
+        printf("Table build failed\n");
+        return 1;
+    }
+
+    // Query streams: uniformly random, and 96 cells that drift slowly between cycles
+    #define ND_CELLS 96
+    #define ND_CYCLES 1000
+    #define ND_QUERIES (ND_CELLS * ND_CYCLES)
+    static float nd_rand[ND_QUERIES][3], nd_track[ND_QUERIES][3];
+    static int32_t nd_rand_q[ND_QUERIES][3], nd_track_q[ND_QUERIES][3];
+    float cell_state[ND_CELLS][3];
+    for (int c = 0; c < ND_CELLS; c++) {
+        cell_state[c][0] = (float)(rand() % 100);
+        cell_state[c][1] = 10.0f + (float)(rand() % 20);
+        cell_state[c][2] = (float)(3.1 + 0.3 * rand() / RAND_MAX);
+    }
+    for (int k = 0; k < ND_CYCLES; k++) {
+        for (int c = 0; c < ND_CELLS; c++) {
+            int idx = k * ND_CELLS + c;
+            nd_rand[idx][0] = -120.0f + 290.0f * rand() / RAND_MAX;
+            nd_rand[idx][1] = -25.0f + 85.0f * rand() / RAND_MAX;
+            nd_rand[idx][2] = (float)(v_lo + (v_hi - v_lo) * rand() / RAND_MAX);
+            cell_state[c][0] += 0.5f * (float)(rand() % 3 - 1);
+            cell_state[c][1] += 0.01f * (float)(rand() % 3 - 1);
+            cell_state[c][2] += 0.0002f * (float)(rand() % 3 - 1);
+            memcpy(nd_track[idx], cell_state[c], sizeof(cell_state[c]));
+            for (int d = 0; d < 3; d++) {
+                nd_rand_q[idx][d] = Interp_RoundQ(nd_rand[idx][d] * scale3[d]);
+                nd_track_q[idx][d] = Interp_RoundQ(nd_track[idx][d] * scale3[d]);
+            }
+        }
+    }
+
+    printf("%-4s %-9s %8s %8s %8s %8s %11s %11s\n", "Dims", "Stream", "Naive", "Fast", "Cursor", "Fixed", "MaxErr", "FixedErr");
+    for (int dims = 2; dims <= 3; dims++) {
+        const Interp_ND *map = (dims == 2) ? &map2 : &map3;
+        for (int stream = 0; stream < 2; stream++) {
+            float (*qf)[3] = stream ? nd_track : nd_rand;
+            int32_t (*qi)[3] = stream ? nd_track_q : nd_rand_q;
+            int off = 3 - dims; // 2D uses (temperature, voltage)
+            Interp_ND_Cursor cursors[ND_CELLS];
+            float acc = 0.0f, max_err = 0.0f, max_fixed_err = 0.0f;
+            double t_ns[4];
+
+            for (int method = 0; method < 4; method++) {
+                memset(cursors, 0, sizeof(cursors));
+                int reps = (method == 0) ? 2 : 20;
+                double t0 = Bench_NowSec();
+                for (int r = 0; r < reps; r++) {
+                    for (int i = 0; i < ND_QUERIES; i++) {
+                        Interp_ND_Cursor *cur = &cursors[i % ND_CELLS];
+                        switch (method) {
+                        case 0: acc += Interp_ND_Naive(map, qf[i] + off); break;
+                        case 1: acc += Interp_ND_Lookup(map, qf[i] + off, NULL); break;
+                        case 2: acc += Interp_ND_Lookup(map, qf[i] + off, cur); break;
+                        default: acc += (float)Interp_ND_LookupFixed(map, qi[i] + off, cur); break;
+                        }
+                    }
+                }
+                t_ns[method] = (Bench_NowSec() - t0) / ((double)reps * ND_QUERIES) * 1e9;
+            }
+            bench_sink = acc;
+
+            for (int i = 0; i < ND_QUERIES; i++) {
+                float fast = Interp_ND_Lookup(map, qf[i] + off, NULL);
+                float e = fabsf(fast - Interp_ND_Naive(map, qf[i] + off));
+                if (e > max_err) max_err = e;
+                float ef = fabsf(Interp_ND_LookupFixed(map, qi[i] + off, NULL) / 100.0f - fast);
+                if (ef > max_fixed_err) max_fixed_err = ef;
+            }
+            printf("%-4d %-9s %8.1f %8.1f %8.1f %8.1f %10.2e%% %10.3f%%\n", dims, stream ? "tracking" : "random",
+                   t_ns[0], t_ns[1], t_ns[2], t_ns[3], max_err, max_fixed_err);
+        }
+    }
+    Interp_ND_Free(&map2);
+    Interp_ND_Free(&map3);
+
+    printf("\n--- PCHIP vs Linear: Original 5-Point LUT ---\n");
+    Interp_Pchip pchip;
+    Interp_Pchip_Build(&pchip, LUT_Voltage, LUT_SOC, TABLE_SIZE);
+    for (int i = 0; i < 6; i++) {
+        float v = test_volts[i];
+        printf("Voltage: %.3f V -> Linear %.2f%% | PCHIP %.2f%%\n", v, GetSOC_From_Voltage(v), Interp_Pchip_Lookup(&pchip, v));
+    }
+    Interp_Pchip_Free(&pchip);
+
+    printf("\n--- Accuracy vs Table Size (uniform-SOC tables, truth = Ocv_Model_Soc) ---\n");
+    printf("%5s %14s %14s %14s %14s\n", "N", "Linear max", "Linear mean", "PCHIP max", "PCHIP mean");
+    #define ACC_POINTS 20000
+    const int acc_sizes[] = { 5, 9, 17, 33, 65, 129, 257, 513 };
+    float pchip_max_at[8], linear_max_at[8];
+    for (int s = 0; s < 8; s++) {
+        int n = acc_sizes[s];
+        Ocv_Model_Table(tab_x, tab_y, n, true);
+        Interp_Table lin;
+        if (!Interp_Build(&lin, tab_x, tab_y, n) || !Interp_Pchip_Build(&pchip, tab_x, tab_y, n)) return 1;
+        double lin_max = 0, lin_sum = 0, pc_max = 0, pc_sum = 0;
+        for (int k = 0; k <= ACC_POINTS; k++) {
+            double v = ocv_min + (ocv_max - ocv_min) * k / ACC_POINTS;
+            double truth = Ocv_Model_Soc(v);
+            double el = fabs(Interp_Lookup(&lin, (float)v) - truth);
+            double ep = fabs(Interp_Pchip_Lookup(&pchip, (float)v) - truth);
+            if (el > lin_max) lin_max = el;
+            if (ep > pc_max) pc_max = ep;
+            lin_sum += el;
+            pc_sum += ep;
+        }
+        linear_max_at[s] = (float)lin_max;
+        pchip_max_at[s] = (float)pc_max;
+        printf("%5d %13.4f%% %13.4f%% %13.4f%% %13.4f%%\n", n, lin_max, lin_sum / (ACC_POINTS + 1),
+               pc_max, pc_sum / (ACC_POINTS + 1));
+        Interp_Free(&lin);
+        Interp_Pchip_Free(&pchip);
+    }
+    for (int s = 0; s < 8; s++) {
+        int match = -1;
+        for (int k = 0; k < 8 && match < 0; k++) {
+            if (linear_max_at[k] <= pchip_max_at[s]) match = acc_sizes[k];
+        }
+        if (match > 0) printf("PCHIP with %3d points ~ linear with %3d points\n", acc_sizes[s], match);
+        else printf("PCHIP with %3d points beats linear with %d points\n", acc_sizes[s], acc_sizes[7]);
+    }
+
+    printf("\n--- Benchmark: ns/lookup, Random Queries ---\n");
+    float acc = 0.0f;
+    double t0 = Bench_NowSec();
+    for (int r = 0; r < 100; r++)
+        for (int i = 0; i < NUM_QUERIES; i++) acc += GetSOC_From_Voltage(q_random[i]);
+    printf("GetSOC_From_Voltage (5 pts):   %6.1f ns\n", (Bench_NowSec() - t0) / (100.0 * NUM_QUERIES) * 1e9);
+    const int speed_sizes[] = { 17, 65, 257 };
+    for (int s = 0; s < 3; s++) {
+        int n = speed_sizes[s];
+        Ocv_Model_Table(tab_x, tab_y, n, true);
+        Interp_Table lin;
+        if (!Interp_Build(&lin, tab_x, tab_y, n) || !Interp_Pchip_Build(&pchip, tab_x, tab_y, n)) return 1;
+        double t_scan = Bench_Scan(&lin, q_random, NUM_QUERIES, 10);
+        t0 = Bench_NowSec();
+        for (int r = 0; r < 100; r++)
+            for (int i = 0; i < NUM_QUERIES; i++) acc += Interp_Lookup(&lin, q_random[i]);
+        double t_lin = (Bench_NowSec() - t0) / (100.0 * NUM_QUERIES) * 1e9;
+        t0 = Bench_NowSec();
+        for (int r = 0; r < 100; r++)
+            for (int i = 0; i < NUM_QUERIES; i++) acc += Interp_Pchip_Lookup(&pchip, q_random[i]);
+        double t_pc = (Bench_NowSec() - t0) / (100.0 * NUM_QUERIES) * 1e9;
+        printf("%3d pts (%s): linear scan %6.1f ns | linear engine %5.1f ns | PCHIP %5.1f ns\n", n,
+               lin.strategy == INTERP_GRID ? "GRID" : "BINARY", t_scan, t_lin, t_pc);
+        Interp_Free(&lin);
+        Interp_Pchip_Free(&pchip);
+    }
+    bench_sink = acc;
+
     return 0;
 }
\ No newline at end of file
@@ -1,5 +1,14 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#include "Fixed_Q.h"
 
 // Configuration
 // Alpha = 0.1. In Fixed Point (Scale 1024): 0.1 * 1024 = 102.4 -> 102
@@ -8,7 +17,19 @@
 #define ALPHA_FIXED  102    // Approx 0.1
 #define ONE_MINUS_ALPHA (SCALE_FACTOR - ALPHA_FIXED) // 922
 
+// Q-format types from Fixed_Q.h
+FX_DEFINE_Q(q16, 16) // Q15.16: general signal chain (mV, mA, degC)
+FX_DEFINE_Q(q24, 24) // Q7.24: small values that need resolution (gains, alphas)
+
+// The float filters below promise separate mul and add roundings. With
+// -march=native (or any target with FMA) GCC would otherwise fuse them, and the
+// scalar reference would no longer match the non-FMA bank kernel bit for bit.
+#define EMA_NO_FMA __attribute__((optimize("fp-contract=off")))
+
 // 1. Reference: Slow Floating Point Implementation
+// always_inline: GCC does not inline across differing optimize() attributes
+// otherwise, and the benchmark loop would measure call overhead.
+static inline EMA_NO_FMA __attribute__((always_inline))
 float EMA_Update_Float(float input, float current_avg) {
     float alpha = 0.1f;
     return (alpha * input) + ((1.0f - alpha) * current_avg);
@@ -30,6 +51,319 @@ int32_t EMA_Update_Fixed(int32_t input, int32_t current_avg) {
     return 0; // Placeholder
 }
 
+// 3. Overflow-safe variant
+// EMA_Update_Fixed() forms ALPHA * input + (SCALE - ALPHA) * avg in int32, which
+// overflows once the inputs pass INT32_MAX / 1024 (about 2.1 V in uV). The same
+// formula with a 64-bit numerator gives identical results where the original
+// works, and correct ones for every int32 input. The result is a weighted mean
+// of two int32 values, so it always fits back into an int32.
+int32_t EMA_Update_Fixed_Safe(int32_t input, int32_t current_avg) {
+    int64_t numerator = (int64_t)ALPHA_FIXED * input + (int64_t)ONE_MINUS_ALPHA * current_avg;
+    return (int32_t)((numerator + (SCALE_FACTOR / 2)) >> SCALE_SHIFT);
+}
+
+// 4. Multi-Channel Filter Bank
+// A pack filters hundreds of cell voltages, currents and temperatures every tick.
+// The bank keeps them in SoA form: avg[], alpha[] and one_minus[] are separate
+// contiguous arrays, so channel i sits in the same lane of every vector and one
+// call updates all N channels:
+//   - Fixed: two int32 multiplies (pmulld), add, +512, arithmetic shift >> 10.
+//     This is EMA_Update_Fixed() lane by lane, including its int32 range.
+//   - Float: separate mul and add, the same operations as EMA_Update_Float(),
+//     so the result is bit-identical (contraction is off on both sides, on any
+//     -march). The FMA kernel saves one rounding and one instruction but rounds
+//     differently (a few ULP after many updates), so it is opt-in
+//     (EMA_Bank_Init(true)) and is checked against fmaf() references instead.
+// Each channel has its own alpha. one_minus[] is precomputed at init time, so
+// the kernels only load and never compute 1 - alpha.
+
+typedef struct {
+    size_t n;
+    int32_t *avg;       // State (same units as the input)
+    int32_t *alpha;     // Q10 weight of the new sample
+    int32_t *one_minus; // SCALE_FACTOR - alpha
+} EMA_BankFixed;
+
+typedef struct {
+    size_t n;
+    float *avg;
+    float *alpha;
+    float *one_minus;   // 1.0f - alpha
+} EMA_BankFloat;
+
+// alpha == NULL: every channel uses ALPHA_FIXED (the same filter as EMA_Update_Fixed)
+bool EMA_BankFixed_Init(EMA_BankFixed *b, size_t n, const int32_t *alpha, int32_t initial) {
+    b->n = n;
+    b->avg = malloc(3 * n * sizeof(int32_t));
+    if (!b->avg) return false;
+    b->alpha = b->avg + n;
+    b->one_minus = b->alpha + n;
+    for (size_t i = 0; i < n; i++) {
+        b->avg[i] = initial;
+        b->alpha[i] = alpha ? alpha[i] : ALPHA_FIXED;
+        b->one_minus[i] = SCALE_FACTOR - b->alpha[i];
+    }
+    return true;
+}
+
+// alpha == NULL: every channel uses 0.1f (the same filter as EMA_Update_Float)
+bool EMA_BankFloat_Init(EMA_BankFloat *b, size_t n, const float *alpha, float initial) {
+    b->n = n;
+    b->avg = malloc(3 * n * sizeof(float));
+    if (!b->avg) return false;
+    b->alpha = b->avg + n;
+    b->one_minus = b->alpha + n;
+    for (size_t i = 0; i < n; i++) {
+        b->avg[i] = initial;
+        b->alpha[i] = alpha ? alpha[i] : 0.1f;
+        b->one_minus[i] = 1.0f - b->alpha[i];
+    }
+    return true;
+}
+
+void EMA_BankFixed_Free(EMA_BankFixed *b) { free(b->avg); b->avg = b->alpha = b->one_minus = NULL; }
+void EMA_BankFloat_Free(EMA_BankFloat *b) { free(b->avg); b->avg = b->alpha = b->one_minus = NULL; }
+
+typedef void (*EMA_BankFixedFn)(EMA_BankFixed *b, const int32_t *input);
+typedef void (*EMA_BankFloatFn)(EMA_BankFloat *b, const float *input);
+
+// Numerator in uint32: wraps like the int32 pmulld lanes instead of being UB
+static inline int32_t EMA_Bank_FixedLane(int32_t x, int32_t avg, int32_t alpha, int32_t one_minus) {
+    uint32_t numerator = (uint32_t)alpha * (uint32_t)x + (uint32_t)one_minus * (uint32_t)avg;
+    return (int32_t)(numerator + (SCALE_FACTOR / 2)) >> SCALE_SHIFT;
+}
+
+void EMA_BankFixed_Update_Scalar(EMA_BankFixed *b, const int32_t *input) {
+    for (size_t i = 0; i < b->n; i++)
+        b->avg[i] = EMA_Bank_FixedLane(input[i], b->avg[i], b->alpha[i], b->one_minus[i]);
+}
+
+EMA_NO_FMA
+void EMA_BankFloat_Update_Scalar(EMA_BankFloat *b, const float *input) {
+    for (size_t i = 0; i < b->n; i++) b->avg[i] = (b->alpha[i] * input[i]) + (b->one_minus[i] * b->avg[i]);
+}
+
+// Explicit fused references for the opt-in FMA kernel: fmaf() rounds once,
+// exactly like vfmadd, on every target
+float EMA_Update_Float_Fma(float input, float current_avg) {
+    float alpha = 0.1f;
+    return fmaf(alpha, input, (1.0f - alpha) * current_avg);
+}
+
+void EMA_BankFloat_Update_ScalarFma(EMA_BankFloat *b, const float *input) {
+    for (size_t i = 0; i < b->n; i++) b->avg[i] = fmaf(b->alpha[i], input[i], b->one_minus[i] * b->avg[i]);
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.1")))
+static void EMA_BankFixed_Update_Sse41(EMA_BankFixed *b, const int32_t *input) {
+    const __m128i half = _mm_set1_epi32(SCALE_FACTOR / 2);
+    size_t i = 0;
+    for (; i + 4 <= b->n; i += 4) {
+        __m128i num = _mm_add_epi32(_mm_mullo_epi32(_mm_loadu_si128((const __m128i *)(b->alpha + i)),
+                                                    _mm_loadu_si128((const __m128i *)(input + i))),
+                                    _mm_mullo_epi32(_mm_loadu_si128((const __m128i *)(b->one_minus + i)),
+                                                    _mm_loadu_si128((const __m128i *)(b->avg + i))));
+        _mm_storeu_si128((__m128i *)(b->avg + i), _mm_srai_epi32(_mm_add_epi32(num, half), SCALE_SHIFT));
+    }
+    for (; i < b->n; i++) b->avg[i] = EMA_Bank_FixedLane(input[i], b->avg[i], b->alpha[i], b->one_minus[i]);
+}
+
+__attribute__((target("avx2")))
+static void EMA_BankFixed_Update_Avx2(EMA_BankFixed *b, const int32_t *input) {
+    const __m256i half = _mm256_set1_epi32(SCALE_FACTOR / 2);
+    size_t i = 0;
+    for (; i + 8 <= b->n; i += 8) {
+        __m256i num = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(b->alpha + i)),
+                                                          _mm256_loadu_si256((const __m256i *)(input + i))),
+                                       _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(b->one_minus + i)),
+                                                          _mm256_loadu_si256((const __m256i *)(b->avg + i))));
+        _mm256_storeu_si256((__m256i *)(b->avg + i), _mm256_srai_epi32(_mm256_add_epi32(num, half), SCALE_SHIFT));
+    }
+    for (; i < b->n; i++) b->avg[i] = EMA_Bank_FixedLane(input[i], b->avg[i], b->alpha[i], b->one_minus[i]); // Inlined, stays VEX
+}
+
+// "avx" only, and no contraction: a target attribute adds to the command line
+// ISA, so under -march=native this function could otherwise still fuse mul + add
+__attribute__((target("avx"))) EMA_NO_FMA
+static void EMA_BankFloat_Update_Avx(EMA_BankFloat *b, const float *input) {
+    size_t i = 0;
+    for (; i + 8 <= b->n; i += 8) {
+        __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(b->alpha + i), _mm256_loadu_ps(input + i)),
+                                 _mm256_mul_ps(_mm256_loadu_ps(b->one_minus + i), _mm256_loadu_ps(b->avg + i)));
+        _mm256_storeu_ps(b->avg + i, r);
+    }
+    for (; i < b->n; i++) b->avg[i] = (b->alpha[i] * input[i]) + (b->one_minus[i] * b->avg[i]);
+}
+
+__attribute__((target("avx2,fma")))
+static void EMA_BankFloat_Update_Fma(EMA_BankFloat *b, const float *input) {
+    size_t i = 0;
+    for (; i + 8 <= b->n; i += 8) {
+        __m256 r = _mm256_fmadd_ps(_mm256_loadu_ps(b->alpha + i), _mm256_loadu_ps(input + i),
+                                   _mm256_mul_ps(_mm256_loadu_ps(b->one_minus + i), _mm256_loadu_ps(b->avg + i)));
+        _mm256_storeu_ps(b->avg + i, r);
+    }
+    for (; i < b->n; i++) b->avg[i] = fmaf(b->alpha[i], input[i], b->one_minus[i] * b->avg[i]);
+}
+#endif
+
+EMA_BankFixedFn EMA_BankFixed_Update = EMA_BankFixed_Update_Scalar;
+EMA_BankFloatFn EMA_BankFloat_Update = EMA_BankFloat_Update_Scalar;
+const char *ema_bank_fixed_impl = "Scalar";
+const char *ema_bank_float_impl = "Scalar";
+
+// Picks the widest kernel the CPU supports. use_fma trades bit-exactness with
+// EMA_Update_Float() for one fused rounding per channel.
+void EMA_Bank_Init(bool use_fma) {
+    EMA_BankFixed_Update = EMA_BankFixed_Update_Scalar;
+    EMA_BankFloat_Update = EMA_BankFloat_Update_Scalar;
+    ema_bank_fixed_impl = ema_bank_float_impl = "Scalar";
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        EMA_BankFixed_Update = EMA_BankFixed_Update_Avx2;
+        ema_bank_fixed_impl = "AVX2";
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        EMA_BankFixed_Update = EMA_BankFixed_Update_Sse41;
+        ema_bank_fixed_impl = "SSE4.1";
+    }
+    if (use_fma && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        EMA_BankFloat_Update = EMA_BankFloat_Update_Fma;
+        ema_bank_float_impl = "AVX2+FMA";
+    } else if (__builtin_cpu_supports("avx")) {
+        EMA_BankFloat_Update = EMA_BankFloat_Update_Avx;
+        ema_bank_float_impl = "AVX";
+    }
+#else
+    (void)use_fma;
+#endif
+}
+
+// 5. Shift-Only EMA (alpha = 2^-K, fixed at compile time)
+// With alpha = 2^-K the update collapses to avg += (x - avg) >> K: one subtract,
+// one shift, one add, and no multiply. Two details make it accurate:
+//   - The state keeps FRAC extra fractional bits (state = avg << FRAC). With
+//     FRAC = 0, a step smaller than 2^(K-1) rounds to 0, so the filter stalls
+//     up to 2^(K-1) LSB short of the input (4 mV for K = 3). With FRAC >= K
+//     those small steps still move the state.
+//   - The step is rounded (+2^(K-1) before the shift), and the output is rounded
+//     back to input units.
+// DEFINE_EMA_SHIFT(name, K, FRAC) generates name_t, name_init(), name_update()
+// and name_value(). K and FRAC are constants, so each instance compiles to
+// shifts and adds only, and the generic multiply path is never built.
+// Range: |x| < 2^(30 - FRAC). The update subtracts two scaled values in int32,
+// and with state and input at opposite ends of the range the difference needs
+// one more bit than (x << FRAC) itself (int64 would double the cost per channel).
+#define DEFINE_EMA_SHIFT(name, K, FRAC)                                                   \
+    _Static_assert((K) >= 1 && (K) <= 15, #name ": K must be 1..15");                      \
+    _Static_assert((FRAC) >= 0 && (FRAC) <= 20, #name ": FRAC must be 0..20");             \
+    typedef int32_t name##_t;                                                             \
+    static inline name##_t name##_init(int32_t x) { return (int32_t)((uint32_t)x << (FRAC)); } \
+    static inline name##_t name##_update(name##_t state, int32_t x) {                     \
+        int32_t diff = (int32_t)((uint32_t)x << (FRAC)) - state;                          \
+        return state + ((diff + ((1 << (K)) >> 1)) >> (K));                              \
+    }                                                                                     \
+    static inline int32_t name##_value(name##_t state) {                                  \
+        return (state + ((1 << (FRAC)) >> 1)) >> (FRAC);                                  \
+    }
+
+DEFINE_EMA_SHIFT(ema_k3, 3, 8)     // alpha = 0.125, 8 extra bits: inputs up to +-4.19M
+DEFINE_EMA_SHIFT(ema_k4, 4, 8)     // alpha = 0.0625
+DEFINE_EMA_SHIFT(ema_k3_raw, 3, 0) // No extra bits: shows the truncation stall
+
+// --- Q-format library: error report and benchmark ---
+static volatile int32_t bench_sink_i;
+static volatile float bench_sink_f;
+
+static double Bench_NowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t bench_seed = 12345;
+static double Rand_Range(double lo, double hi) {
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (bench_seed >> 8) / 16777216.0;
+}
+
+typedef enum { OP_ADD, OP_MUL, OP_DIV, OP_RECIP, OP_SQRT, OP_LOG2, OP_LN, OP_EXP2, OP_EXP, OP_COUNT } Fx_Op;
+static const char *fx_op_names[OP_COUNT] = { "add (sat)", "mul", "div", "recip", "sqrt", "log2", "ln", "exp2", "exp" };
+
+// Operands in the op's useful domain (results stay inside Q15.16)
+static void Fx_Operands(Fx_Op op, double *a, double *b) {
+    *b = 0.0;
+    switch (op) {
+    case OP_ADD:   *a = Rand_Range(-30000, 30000); *b = Rand_Range(-30000, 30000); break;
+    case OP_MUL:   *a = Rand_Range(-180, 180);     *b = Rand_Range(-180, 180); break;
+    case OP_DIV:   *a = Rand_Range(-1000, 1000);   *b = Rand_Range(0.05, 1000) * (Rand_Range(0, 1) < 0.5 ? -1 : 1); break;
+    case OP_RECIP: *a = Rand_Range(0.001, 1000) * (Rand_Range(0, 1) < 0.5 ? -1 : 1); break;
+    case OP_SQRT:  *a = Rand_Range(0, 32767); break;
+    case OP_LOG2:
+    case OP_LN:    *a = Rand_Range(0.0001, 32767); break;
+    case OP_EXP2:  *a = Rand_Range(-16, 14.9); break;
+    default:       *a = Rand_Range(-11, 10.3); break;
+    }
+}
+
+static double Fx_Reference(Fx_Op op, double a, double b) {
+    double r;
+    switch (op) {
+    case OP_ADD:   r = a + b; break;
+    case OP_MUL:   r = a * b; break;
+    case OP_DIV:   r = a / b; break;
+    case OP_RECIP: r = 1.0 / a; break;
+    case OP_SQRT:  r = sqrt(a); break;
+    case OP_LOG2:  r = log2(a); break;
+    case OP_LN:    r = log(a); break;
+    case OP_EXP2:  r = exp2(a); break;
+    default:       r = exp(a); break;
+    }
+    return (r > 32767.99998) ? 32767.99998 : (r < -32768.0) ? -32768.0 : r; // Saturation limits
+}
+
+static inline q16_t Fx_Q16(Fx_Op op, q16_t a, q16_t b) {
+    switch (op) {
+    case OP_ADD:   return q16_add(a, b);
+    case OP_MUL:   return q16_mul(a, b);
+    case OP_DIV:   return q16_div(a, b);
+    case OP_RECIP: return q16_recip(a);
+    case OP_SQRT:  return q16_sqrt(a);
+    case OP_LOG2:  return q16_log2(a);
+    case OP_LN:    return q16_ln(a);
+    case OP_EXP2:  return q16_exp2(a);
+    default:       return q16_exp(a);
+    }
+}
+
+static inline float Fx_Float(Fx_Op op, float a, float b) {
+    switch (op) {
+    case OP_ADD:   return a + b;
+    case OP_MUL:   return a * b;
+    case OP_DIV:   return a / b;
+    case OP_RECIP: return 1.0f / a;
+    case OP_SQRT:  return sqrtf(a);
+    case OP_LOG2:  return log2f(a);
+    case OP_LN:    return logf(a);
+    case OP_EXP2:  return exp2f(a);
+    default:       return expf(a);
+    }
+}
+
+// Largest distance in ULPs between two float arrays (same-sign values)
+static int32_t Bank_MaxUlp(const float *a, const float *b, size_t n) {
+    int32_t worst = 0;
+    for (size_t i = 0; i < n; i++) {
+        int32_t ia, ib;
+        memcpy(&ia, &a[i], 4);
+        memcpy(&ib, &b[i], 4);
+        int32_t d = ia > ib ? ia - ib : ib - ia;
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
 int main() {
     // Scenario: Battery Voltage in millivolts (mV)
     // Start with a baseline of 3300 mV
@@ -57,5 +391,271 @@ int main() {
     // Note: Small errors (off by 1) are acceptable due to integer truncation.
     // Large errors mean the math is wrong.
 
-    return 0;
+    printf("\n--- Overflow-Safe EMA ---\n");
+    int mismatch = 0;
+    for (int32_t x = -1000000; x <= 1000000; x += 997) { // |922 * x| < 2^31
+        int32_t avg = x / 2 + 1234;
+        if (EMA_Update_Fixed_Safe(x, avg) != EMA_Update_Fixed(x, avg)) mismatch++;
+    }
+    printf("Safe vs original where the original cannot overflow: %s\n", mismatch ? "MISMATCH!" : "IDENTICAL");
+    float f_uv = 3300000.0f;
+    int32_t s_uv = 3300000;
+    for (int i = 0; i < 5; i++) {
+        f_uv = EMA_Update_Float(4200000.0f, f_uv);
+        s_uv = EMA_Update_Fixed_Safe(4200000, s_uv);
+    }
+    printf("uV scale, 5 steps to 4.2 V: float %.0f | safe fixed %d\n", f_uv, s_uv);
+
+    printf("\n--- Q15.16 Library: Error vs Double Reference (LSB = 2^-16) ---\n");
+    printf("%-10s %10s %10s %10s %12s %12s %8s\n", "Op", "Max LSB", "Mean LSB", "Max rel", "Fixed ns/op", "Float ns/op", "Ratio");
+    #define FX_SAMPLES 200000
+    static q16_t qa[FX_SAMPLES], qb[FX_SAMPLES];
+    static float fa[FX_SAMPLES], fb[FX_SAMPLES];
+    for (int op = 0; op < OP_COUNT; op++) {
+        double max_lsb = 0.0, sum_lsb = 0.0, max_rel = 0.0;
+        for (int i = 0; i < FX_SAMPLES; i++) {
+            double a, b;
+            Fx_Operands((Fx_Op)op, &a, &b);
+            qa[i] = q16_from_float((float)a);
+            qb[i] = q16_from_float((float)b);
+            fa[i] = q16_to_float(qa[i]);
+            fb[i] = q16_to_float(qb[i]);
+            // Reference on the exact values the fixed-point inputs represent
+            double ref = Fx_Reference((Fx_Op)op, qa[i] / 65536.0, qb[i] / 65536.0);
+            double err = fabs(Fx_Q16((Fx_Op)op, qa[i], qb[i]) / 65536.0 - ref) * 65536.0;
+            if (err > max_lsb) max_lsb = err;
+            sum_lsb += err;
+            if (fabs(ref) > 1.0 && err / 65536.0 / fabs(ref) > max_rel) max_rel = err / 65536.0 / fabs(ref);
+        }
+
+        uint32_t acc_i = 0; // Checksum only: wraps instead of overflowing
+        float acc_f = 0.0f;
+        double t0 = Bench_NowSec();
+        for (int r = 0; r < 10; r++)
+            for (int i = 0; i < FX_SAMPLES; i++) acc_i += (uint32_t)Fx_Q16((Fx_Op)op, qa[i], qb[i]);
+        double t_fixed = (Bench_NowSec() - t0) / (10.0 * FX_SAMPLES) * 1e9;
+        t0 = Bench_NowSec();
+        for (int r = 0; r < 10; r++)
+            for (int i = 0; i < FX_SAMPLES; i++) acc_f += Fx_Float((Fx_Op)op, fa[i], fb[i]);
+        double t_float = (Bench_NowSec() - t0) / (10.0 * FX_SAMPLES) * 1e9;
+        bench_sink_i = (int32_t)acc_i;
+        bench_sink_f = acc_f;
+
+        printf("%-10s %10.2f %10.3f %10.1e %12.2f %12.2f %7.1fx\n", fx_op_names[op], max_lsb, sum_lsb / FX_SAMPLES,
+               max_rel, t_fixed, t_float, t_fixed / t_float);
+    }
+
+    printf("\n--- Rounding Modes (Q15.16 mul, 1M random products) ---\n");
+    const char *mode_names[3] = { "floor", "nearest", "even" };
+    for (int m = 0; m < 3; m++) {
+        double bias = 0.0, max_lsb = 0.0;
+        for (int i = 0; i < 1000000; i++) {
+            q16_t a = (q16_t)Rand_Range(-180 * 65536.0, 180 * 65536.0);
+            q16_t b = (q16_t)Rand_Range(-2 * 65536.0, 2 * 65536.0);
+            double err = q16_mul_r(a, b, (Fx_Round)m) - (double)a * b / 65536.0;
+            bias += err;
+            if (fabs(err) > max_lsb) max_lsb = fabs(err);
+        }
+        printf("%-8s max %.3f LSB, mean (bias) %+.4f LSB\n", mode_names[m], max_lsb, bias / 1000000);
+    }
+
+    printf("\n--- Q7.24 (high-resolution gains) ---\n");
+    q24_t g = q24_from_float(0.7071068f);
+    printf("sqrt(0.5) = %.8f | 1/0.7071 = %.8f | ln(0.7071) = %.8f | exp(-0.3466) = %.8f\n",
+           q24_to_float(q24_sqrt(q24_from_float(0.5f))), q24_to_float(q24_recip(g)),
+           q24_to_float(q24_ln(g)), q24_to_float(q24_exp(q24_from_float(-0.3465736f))));
+
+    printf("\n--- EMA Filter Bank ---\n");
+    #define BANK_MAX 4096
+    #define BANK_TICKS 1000
+    #define BANK_INPUTS 8 // Rotating input frames, so every tick sees fresh data
+    static int32_t bank_in_i[BANK_INPUTS][BANK_MAX], ref_i[BANK_MAX], alpha_q[BANK_MAX];
+    static float bank_in_f[BANK_INPUTS][BANK_MAX], ref_f[BANK_MAX], alpha_f[BANK_MAX];
+    for (int k = 0; k < BANK_INPUTS; k++)
+        for (int i = 0; i < BANK_MAX; i++) {
+            bank_in_i[k][i] = (int32_t)Rand_Range(2500.0, 4200.0); // mV
+            bank_in_f[k][i] = (float)Rand_Range(2500.0, 4200.0);
+        }
+    for (int i = 0; i < BANK_MAX; i++) {
+        alpha_q[i] = 1 + (int32_t)Rand_Range(0.0, SCALE_FACTOR - 1);
+        alpha_f[i] = alpha_q[i] / (float)SCALE_FACTOR;
+    }
+
+    // Bit-exactness: uniform alpha against the scalar functions, per-channel alpha
+    // against the scalar bank. 1027 channels leave a tail for every vector width.
+    // The FMA kernel is held to the fmaf() references, the others to the unfused ones.
+    EMA_BankFixed bfx, bfx_ref;
+    EMA_BankFloat bfl, bfl_ref;
+    int bank_failures = 0;
+    for (int use_fma = 0; use_fma <= 1; use_fma++) {
+        EMA_Bank_Init(use_fma);
+        bool fused = strcmp(ema_bank_float_impl, "AVX2+FMA") == 0;
+        float (*float_ref)(float, float) = fused ? EMA_Update_Float_Fma : EMA_Update_Float;
+        EMA_BankFloatFn float_bank_ref = fused ? EMA_BankFloat_Update_ScalarFma : EMA_BankFloat_Update_Scalar;
+        size_t n = 1027;
+        EMA_BankFixed_Init(&bfx, n, NULL, 3300);
+        EMA_BankFloat_Init(&bfl, n, NULL, 3300.0f);
+        for (size_t i = 0; i < n; i++) { ref_i[i] = 3300; ref_f[i] = 3300.0f; }
+        for (int t = 0; t < BANK_TICKS; t++) {
+            EMA_BankFixed_Update(&bfx, bank_in_i[t % BANK_INPUTS]);
+            EMA_BankFloat_Update(&bfl, bank_in_f[t % BANK_INPUTS]);
+            for (size_t i = 0; i < n; i++) {
+                ref_i[i] = EMA_Update_Fixed(bank_in_i[t % BANK_INPUTS][i], ref_i[i]);
+                ref_f[i] = float_ref(bank_in_f[t % BANK_INPUTS][i], ref_f[i]);
+            }
+        }
+        bool fixed_same = memcmp(bfx.avg, ref_i, n * sizeof(int32_t)) == 0;
+        int32_t float_ulp = Bank_MaxUlp(bfl.avg, ref_f, n);
+        EMA_BankFixed_Free(&bfx);
+        EMA_BankFloat_Free(&bfl);
+
+        EMA_BankFixed_Init(&bfx, n, alpha_q, 3300);
+        EMA_BankFixed_Init(&bfx_ref, n, alpha_q, 3300);
+        EMA_BankFloat_Init(&bfl, n, alpha_f, 3300.0f);
+        EMA_BankFloat_Init(&bfl_ref, n, alpha_f, 3300.0f);
+        for (int t = 0; t < BANK_TICKS; t++) {
+            EMA_BankFixed_Update(&bfx, bank_in_i[t % BANK_INPUTS]);
+            EMA_BankFixed_Update_Scalar(&bfx_ref, bank_in_i[t % BANK_INPUTS]);
+            EMA_BankFloat_Update(&bfl, bank_in_f[t % BANK_INPUTS]);
+            float_bank_ref(&bfl_ref, bank_in_f[t % BANK_INPUTS]);
+        }
+        bool fixed_alpha_same = memcmp(bfx.avg, bfx_ref.avg, n * sizeof(int32_t)) == 0;
+        int32_t float_alpha_ulp = Bank_MaxUlp(bfl.avg, bfl_ref.avg, n);
+        EMA_BankFixed_Free(&bfx);
+        EMA_BankFixed_Free(&bfx_ref);
+        EMA_BankFloat_Free(&bfl);
+        EMA_BankFloat_Free(&bfl_ref);
+
+        bool float_same = float_ulp == 0 && float_alpha_ulp == 0;
+        if (!fixed_same || !fixed_alpha_same || !float_same) bank_failures++;
+        printf("Fixed %-6s vs EMA_Update_Fixed: %s | per-channel alpha vs scalar bank: %s\n", ema_bank_fixed_impl,
+               fixed_same ? "IDENTICAL" : "MISMATCH!", fixed_alpha_same ? "IDENTICAL" : "MISMATCH!");
+        printf("Float %-8s vs %s: max %d ULP | per-channel alpha vs scalar bank%s: max %d ULP -> %s\n",
+               ema_bank_float_impl, fused ? "fmaf() reference" : "EMA_Update_Float", float_ulp,
+               fused ? " (fmaf)" : "", float_alpha_ulp, float_same ? "IDENTICAL" : "MISMATCH!");
+    }
+
+    // Throughput: the scalar functions in a loop vs one bank call per tick
+    printf("%8s %14s %12s %14s %12s %12s\n", "Channels", "Fixed loop", "Fixed bank", "Float loop", "Float bank", "Float FMA");
+    const size_t bank_sizes[3] = { 96, 480, BANK_MAX };
+    for (int s = 0; s < 3; s++) {
+        size_t n = bank_sizes[s];
+        int ticks = (int)(20000000 / n);
+        double rate[5];
+        for (size_t i = 0; i < n; i++) { ref_i[i] = 3300; ref_f[i] = 3300.0f; }
+
+        double t0 = Bench_NowSec();
+        for (int t = 0; t < ticks; t++) {
+            const int32_t *in = bank_in_i[t % BANK_INPUTS];
+            for (size_t i = 0; i < n; i++) ref_i[i] = EMA_Update_Fixed(in[i], ref_i[i]);
+        }
+        rate[0] = Bench_NowSec() - t0;
+        t0 = Bench_NowSec();
+        for (int t = 0; t < ticks; t++) {
+            const float *in = bank_in_f[t % BANK_INPUTS];
+            for (size_t i = 0; i < n; i++) ref_f[i] = EMA_Update_Float(in[i], ref_f[i]);
+        }
+        rate[2] = Bench_NowSec() - t0;
+
+        for (int use_fma = 0; use_fma <= 1; use_fma++) {
+            EMA_Bank_Init(use_fma);
+            EMA_BankFixed_Init(&bfx, n, alpha_q, 3300);
+            EMA_BankFloat_Init(&bfl, n, alpha_f, 3300.0f);
+            if (!use_fma) {
+                t0 = Bench_NowSec();
+                for (int t = 0; t < ticks; t++) EMA_BankFixed_Update(&bfx, bank_in_i[t % BANK_INPUTS]);
+                rate[1] = Bench_NowSec() - t0;
+            }
+            t0 = Bench_NowSec();
+            for (int t = 0; t < ticks; t++) EMA_BankFloat_Update(&bfl, bank_in_f[t % BANK_INPUTS]);
+            rate[3 + use_fma] = Bench_NowSec() - t0;
+            bench_sink_i = bfx.avg[n - 1] + ref_i[n - 1];
+            bench_sink_f = bfl.avg[n - 1] + ref_f[n - 1];
+            EMA_BankFixed_Free(&bfx);
+            EMA_BankFloat_Free(&bfl);
+        }
+        for (int k = 0; k < 5; k++) rate[k] = (double)n * ticks / rate[k] * 1e-6;
+        printf("%8zu %14.0f %12.0f %14.0f %12.0f %12.0f   channels/us\n", n, rate[0], rate[1], rate[2], rate[3], rate[4]);
+    }
+    EMA_Bank_Init(false);
+
+    printf("\n--- Shift-Only EMA (avg += (x - avg) >> K) ---\n");
+    // Steady state: step from 3300 mV to a random target, run until settled, and
+    // measure how far the output stops from the target
+    #define SETTLE_TICKS 400
+    #define STEP_TRIALS 20000
+    const char *shift_names[4] = { "EMA_Update_Fixed (alpha 102/1024)", "ema_k3 (alpha 1/8, 8 frac bits)",
+                                   "ema_k4 (alpha 1/16, 8 frac bits)", "ema_k3_raw (alpha 1/8, no frac bits)" };
+    for (int f = 0; f < 4; f++) {
+        int32_t worst = 0;
+        int64_t sum = 0;
+        for (int trial = 0; trial < STEP_TRIALS; trial++) {
+            int32_t target = (int32_t)Rand_Range(2500.0, 4200.0);
+            int32_t out = 0, fixed = 3300;
+            ema_k3_t s3 = ema_k3_init(3300);
+            ema_k4_t s4 = ema_k4_init(3300);
+            ema_k3_raw_t sr = ema_k3_raw_init(3300);
+            for (int t = 0; t < SETTLE_TICKS; t++) {
+                if (f == 0) fixed = EMA_Update_Fixed(target, fixed);
+                else if (f == 1) s3 = ema_k3_update(s3, target);
+                else if (f == 2) s4 = ema_k4_update(s4, target);
+                else sr = ema_k3_raw_update(sr, target);
+            }
+            out = (f == 0) ? fixed : (f == 1) ? ema_k3_value(s3) : (f == 2) ? ema_k4_value(s4) : ema_k3_raw_value(sr);
+            int32_t err = out > target ? out - target : target - out;
+            if (err > worst) worst = err;
+            sum += err;
+        }
+        printf("%-38s steady-state error: max %d mV, mean %.2f mV\n", shift_names[f], worst, (double)sum / STEP_TRIALS);
+    }
+
+    // Range: full-scale swings between the opposite limits of |x| < 2^(30 - FRAC).
+    // The first step has the largest int32 difference the filter can see (run
+    // under -fsanitize=undefined to check it), and the output must never leave
+    // [lo, hi] and must settle exactly on each end.
+    const int32_t shift_hi = (1 << (30 - 8)) - 1, shift_lo = -shift_hi;
+    bool shift_range_ok = true;
+    ema_k3_t s3 = ema_k3_init(shift_lo);
+    ema_k4_t s4 = ema_k4_init(shift_lo);
+    for (int swing = 0; swing < 4; swing++) {
+        int32_t target = (swing % 2 == 0) ? shift_hi : shift_lo;
+        for (int t = 0; t < 1000; t++) {
+            s3 = ema_k3_update(s3, target);
+            s4 = ema_k4_update(s4, target);
+            int32_t v3 = ema_k3_value(s3), v4 = ema_k4_value(s4);
+            if (v3 < shift_lo || v3 > shift_hi || v4 < shift_lo || v4 > shift_hi) shift_range_ok = false;
+        }
+        if (ema_k3_value(s3) != target || ema_k4_value(s4) != target) shift_range_ok = false;
+    }
+    printf("Full-scale swings between +-%d (ema_k3, ema_k4): %s\n", shift_hi, shift_range_ok ? "OK" : "FAILED");
+
+    // Speed: one filter's dependent chain (MCU style) and 96 independent channels
+    #define SHIFT_SAMPLES 4096
+    #define SHIFT_REPEAT 2000
+    static int32_t noisy_mv[SHIFT_SAMPLES];
+    for (int i = 0; i < SHIFT_SAMPLES; i++) noisy_mv[i] = 3300 + (int32_t)Rand_Range(-50.0, 50.0);
+    double t_chain[2], t_pack[2];
+    for (int f = 0; f < 2; f++) {
+        int32_t state = (f == 0) ? 3300 : ema_k3_init(3300);
+        double t0 = Bench_NowSec();
+        for (int r = 0; r < SHIFT_REPEAT; r++)
+            for (int i = 0; i < SHIFT_SAMPLES; i++)
+                state = (f == 0) ? EMA_Update_Fixed(noisy_mv[i], state) : ema_k3_update(state, noisy_mv[i]);
+        t_chain[f] = (Bench_NowSec() - t0) / ((double)SHIFT_REPEAT * SHIFT_SAMPLES) * 1e9;
+        bench_sink_i = state;
+
+        for (int i = 0; i < 96; i++) ref_i[i] = (f == 0) ? 3300 : ema_k3_init(3300);
+        t0 = Bench_NowSec();
+        for (int r = 0; r < SHIFT_REPEAT; r++)
+            for (int b = 0; b + 96 <= SHIFT_SAMPLES; b += 96) {
+                if (f == 0) for (int i = 0; i < 96; i++) ref_i[i] = EMA_Update_Fixed(noisy_mv[b + i], ref_i[i]);
+                else        for (int i = 0; i < 96; i++) ref_i[i] = ema_k3_update(ref_i[i], noisy_mv[b + i]);
+            }
+        t_pack[f] = (Bench_NowSec() - t0) / ((double)SHIFT_REPEAT * (SHIFT_SAMPLES / 96 * 96)) * 1e9;
+        bench_sink_i = ref_i[95];
+    }
+    printf("ns/update  single filter: EMA_Update_Fixed %.2f | ema_k3 %.2f   96 channels: %.3f | %.3f\n",
+           t_chain[0], t_chain[1], t_pack[0], t_pack[1]);
+
+    return (bank_failures == 0 && shift_range_ok) ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+#ifndef FIXED_Q_H
+#define FIXED_Q_H
+
+// Q-Format Fixed-Point Library (Header-Only)
+// Grown from EMA_Update_Fixed(): the same "scale by 2^n, shift back down" idea,
+// for the whole signal chain on an MCU without an FPU.
+//   - FX_DEFINE_Q(name, FRAC) generates a Qm.n type in an int32_t:
+//         FX_DEFINE_Q(q16, 16)  ->  q16_t, q16_add(), q16_mul(), q16_div() ...
+//     FRAC is a compile-time constant. Every shift and rounding constant folds
+//     away, so each wrapper compiles to the code you would write by hand.
+//   - Every result saturates to [INT32_MIN, INT32_MAX] instead of wrapping.
+//   - Products use a 64-bit intermediate, so they cannot overflow before the
+//     shift. This is the bug that EMA_Update_Fixed() has for large inputs.
+//   - Division and sqrt use Newton-Raphson (reciprocal, reciprocal square root)
+//     plus an exact integer correction, so they round correctly and never
+//     execute a divide instruction. log2 and exp2 normalize with CLZ and use
+//     Q30 polynomials. All of these need only integer multiply, shift and add.
+
+#include <stdint.h>
+
+typedef enum {
+    FX_ROUND_FLOOR = 0,     // Arithmetic shift: toward -infinity (cheapest)
+    FX_ROUND_NEAREST,       // Half up: add 0.5 LSB, then shift (as EMA_Update_Fixed)
+    FX_ROUND_EVEN           // Half to even: no bias on long accumulations
+} Fx_Round;
+
+// --- Core helpers (FRAC arrives as a constant through the generated wrappers) ---
+static inline int32_t fx_sat32(int64_t v) {
+    return (v > INT32_MAX) ? INT32_MAX : (v < INT32_MIN) ? INT32_MIN : (int32_t)v;
+}
+
+static inline int fx_clz32(uint32_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return v ? __builtin_clz(v) : 32;
+#else
+    int n = 0;
+    if (v == 0) return 32;
+    while (!(v & 0x80000000u)) {
+        v <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// v / 2^shift with the chosen rounding (shift >= 1)
+static inline int64_t fx_round_shift(int64_t v, int shift, Fx_Round mode) {
+    int64_t half = (int64_t)1 << (shift - 1);
+    switch (mode) {
+    case FX_ROUND_NEAREST:
+        return (v + half) >> shift;
+    case FX_ROUND_EVEN: {
+        int64_t q = v >> shift, rem = v & ((half << 1) - 1);
+        return q + ((rem > half) | ((rem == half) & (q & 1)));
+    }
+    default:
+        return v >> shift;
+    }
+}
+
+// v * 2^shift for any sign of shift, saturated to int32
+static inline int32_t fx_scale_sat(int64_t v, int shift, Fx_Round mode) {
+    if (shift > 62) return (mode == FX_ROUND_FLOOR && v < 0) ? -1 : 0; // Underflow
+    if (shift > 0) return fx_sat32(fx_round_shift(v, shift, mode));
+    if (shift == 0) return fx_sat32(v);
+    if (shift <= -32) return (v == 0) ? 0 : (v > 0) ? INT32_MAX : INT32_MIN;
+    if (v > (INT32_MAX >> -shift)) return INT32_MAX;
+    if (v < (INT32_MIN >> -shift)) return INT32_MIN;
+    return (int32_t)(v * ((int64_t)1 << -shift));
+}
+
+static inline int32_t fx_mul_raw(int32_t a, int32_t b, int frac, Fx_Round mode) {
+    return fx_scale_sat((int64_t)a * b, frac, mode);
+}
+
+// 1/u for u > 0, as x * 2^(s - 62): x is Q30 in (1, 2], s = clz(u)
+static inline uint64_t fx_recip_core(uint32_t u, int *s) {
+    *s = fx_clz32(u);
+    uint64_t d = (uint64_t)u << *s;                          // D = d / 2^32 in [0.5, 1)
+    int64_t x = 3031741621 - (int64_t)((d * 2021161081) >> 32); // 48/17 - 32/17 * D (Q30)
+    for (int i = 0; i < 3; i++) {                            // Error 1/17 -> 1/17^8
+        int64_t e = ((int64_t)1 << 62) - (int64_t)(d * (uint64_t)x); // 1 - D*X (Q62)
+        x += (x * (e >> 30)) >> 32;
+    }
+    return (uint64_t)x;
+}
+
+static inline int32_t fx_div_raw(int32_t a, int32_t b, int frac) {
+    if (b == 0) return (a >= 0) ? INT32_MAX : INT32_MIN;
+    int neg = (a < 0) != (b < 0);
+    uint32_t ua = (a < 0) ? 0u - (uint32_t)a : (uint32_t)a;
+    uint32_t ub = (b < 0) ? 0u - (uint32_t)b : (uint32_t)b;
+    int s;
+    uint64_t x = fx_recip_core(ub, &s);
+    // a / b = a * x * 2^(s - 62) in real terms; the result is scaled by 2^frac.
+    // shift = 62 - s - frac is always in [1, 61].
+    int shift = 62 - s - frac;
+    uint64_t q = ((uint64_t)ua * x) >> shift;                // Within 1-2 of the true quotient
+    // Exact rounding: fix q with the remainder of (ua << frac) / ub (multiplies only)
+    int64_t num = (int64_t)((uint64_t)ua << frac);
+    int64_t rem = num - (int64_t)(q * ub);
+    while (rem < 0) {
+        q--;
+        rem += ub;
+    }
+    while (rem >= (int64_t)ub) {
+        q++;
+        rem -= ub;
+    }
+    q += (2 * (uint64_t)rem >= ub);                          // Round half up
+    if (q > (uint64_t)INT32_MAX + neg) return neg ? INT32_MIN : INT32_MAX;
+    return neg ? (int32_t)(0u - (uint32_t)q) : (int32_t)q;
+}
+
+// Square root of v < 2^62, rounded to nearest. Newton-Raphson on 1/sqrt(M)
+// (multiplies only, no divide), then an exact integer correction.
+static inline uint32_t fx_isqrt64(uint64_t v) {
+    if (v == 0) return 0;
+    int lz = (fx_clz32((uint32_t)(v >> 32)) + ((v >> 32) ? 0 : fx_clz32((uint32_t)v))) & ~1; // Even
+    uint64_t m = (v << lz) >> 32;                            // M = m / 2^32 in [0.25, 1)
+    int64_t y = 2362232013 - (int64_t)((m * 1288490189) >> 32); // 2.2 - 1.2 * M ~ 1/sqrt(M), Q30
+    for (int i = 0; i < 4; i++) {                            // Error 13% -> 3e-12
+        int64_t yy = (y * y) >> 30;                          // y^2, Q30
+        int64_t u = (int64_t)((m * (uint64_t)yy) >> 32);     // M * y^2 ~ 1, Q30
+        y = (y * (((int64_t)3 << 30) - u)) >> 31;            // y * (3 - M y^2) / 2
+    }
+    uint64_t r = (m * (uint64_t)y) >> 32;                    // sqrt(M) = M * y, Q30
+    int sh = lz / 2 - 2;                                     // sqrt(v) = sqrt(M) * 2^(32 - lz/2)
+    r = (sh >= 0) ? (r >> sh) : (r << -sh);
+    while (r * r > v) r--;
+    while ((r + 1) * (r + 1) <= v) r++;
+    return (uint32_t)(r + (v - r * r > r));                  // (r + 0.5)^2 < v  <=>  v - r^2 > r
+}
+
+static inline int32_t fx_sqrt_raw(int32_t a, int frac) {
+    if (a <= 0) return 0;
+    return (int32_t)fx_isqrt64((uint64_t)a << frac);
+}
+
+// Q30 polynomials (near-minimax Chebyshev fits on [0, 1))
+// log2(1 + f): max error 9e-9.  2^f: max error 6e-11.
+static const int64_t FX_LOG2_POLY[10] = { 0, 1549080120, -774477404, 515511779, -381367999,
+                                          285362381, -192817251, 101829719, -35052638, 5673113 };
+static const int64_t FX_EXP2_POLY[8] = { 1073741824, 744261126, 257941089, 59598342,
+                                         10322487, 1441968, 153573, 23239 };
+
+static inline int64_t fx_poly_q30(const int64_t *c, int degree, int64_t f) {
+    int64_t acc = c[degree];
+    for (int i = degree - 1; i >= 0; i--) acc = ((acc * f) >> 30) + c[i];
+    return acc;
+}
+
+static inline int32_t fx_log2_raw(int32_t a, int frac) {
+    if (a <= 0) return INT32_MIN;                            // log2(0) = -inf
+    int msb = 31 - fx_clz32((uint32_t)a);
+    int64_t f = ((int64_t)a << (30 - msb)) - ((int64_t)1 << 30); // Mantissa - 1, Q30 in [0, 1)
+    int64_t frac_part = fx_poly_q30(FX_LOG2_POLY, 9, f);
+    int64_t whole = (int64_t)(msb - frac) * ((int64_t)1 << 30);
+    return fx_scale_sat(whole + frac_part, 30 - frac, FX_ROUND_NEAREST);
+}
+
+// 2^(x / 2^xfrac) in Q frac. A wide x (xfrac >= 30) keeps the full fraction, so
+// e^a = 2^(a * log2(e)) does not lose the product's low bits before the split.
+static inline int32_t fx_exp2_wide(int64_t x, int xfrac, int frac) {
+    int64_t k = x >> xfrac;                                  // floor(x)
+    int64_t f = (x - k * ((int64_t)1 << xfrac)) >> (xfrac - 30); // Q30 in [0, 1)
+    if (k > 62) return INT32_MAX;
+    if (k < -62) return 0;
+    int64_t p = fx_poly_q30(FX_EXP2_POLY, 7, f);             // 2^f, Q30 in [1, 2)
+    return fx_scale_sat(p, 30 - frac - (int)k, FX_ROUND_NEAREST);
+}
+
+static inline int32_t fx_exp2_raw(int32_t a, int frac) {
+    return fx_exp2_wide((int64_t)a * ((int64_t)1 << 30), frac + 30, frac);
+}
+
+#define FX_LOG2E_Q30 1549082005 // log2(e)
+#define FX_LN2_Q30   744261118  // ln(2)
+
+// --- Generator: one Qm.n type and its operations ---
+#define FX_DEFINE_Q(name, FRAC)                                                          \
+    _Static_assert((FRAC) >= 1 && (FRAC) <= 30, #name ": FRAC must be 1..30");            \
+    typedef int32_t name##_t;                                                            \
+    enum { name##_FRAC = (FRAC) };                                                       \
+    static inline name##_t name##_from_int(int32_t i) { return fx_scale_sat(i, -(FRAC), FX_ROUND_FLOOR); } \
+    /* Float conversion is for host-side tables and tests only */                       \
+    static inline name##_t name##_from_float(float f) {                                  \
+        float s = f * (float)(1u << (FRAC));                                             \
+        if (s >= 2147483647.0f) return INT32_MAX;                                        \
+        if (s <= -2147483648.0f) return INT32_MIN;                                       \
+        return (int32_t)(s >= 0.0f ? s + 0.5f : s - 0.5f);                               \
+    }                                                                                    \
+    static inline float name##_to_float(name##_t a) { return (float)a / (float)(1u << (FRAC)); } \
+    static inline name##_t name##_add(name##_t a, name##_t b) { return fx_sat32((int64_t)a + b); } \
+    static inline name##_t name##_sub(name##_t a, name##_t b) { return fx_sat32((int64_t)a - b); } \
+    static inline name##_t name##_mul_r(name##_t a, name##_t b, Fx_Round mode) {         \
+        return fx_mul_raw(a, b, (FRAC), mode);                                           \
+    }                                                                                    \
+    static inline name##_t name##_mul(name##_t a, name##_t b) { return fx_mul_raw(a, b, (FRAC), FX_ROUND_NEAREST); } \
+    static inline name##_t name##_div(name##_t a, name##_t b) { return fx_div_raw(a, b, (FRAC)); } \
+    static inline name##_t name##_recip(name##_t a) { return fx_div_raw((int32_t)1 << (FRAC), a, (FRAC)); } \
+    static inline name##_t name##_sqrt(name##_t a) { return fx_sqrt_raw(a, (FRAC)); }    \
+    static inline name##_t name##_log2(name##_t a) { return fx_log2_raw(a, (FRAC)); }    \
+    static inline name##_t name##_exp2(name##_t a) { return fx_exp2_raw(a, (FRAC)); }    \
+    static inline name##_t name##_ln(name##_t a) {                                       \
+        int32_t l = fx_log2_raw(a, (FRAC));                                              \
+        return (l == INT32_MIN) ? INT32_MIN : fx_mul_raw(l, FX_LN2_Q30, 30, FX_ROUND_NEAREST); \
+    }                                                                                    \
+    static inline name##_t name##_exp(name##_t a) { /* e^a = 2^(a * log2(e)) */         \
+        return fx_exp2_wide((int64_t)a * FX_LOG2E_Q30, (FRAC) + 30, (FRAC));             \
+    }
+
+#endif // FIXED_Q_H
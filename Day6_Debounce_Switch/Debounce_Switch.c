@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 typedef struct {
     uint8_t counter;       // "Integrator" value (0 to 100)
@@ -46,6 +49,420 @@ void Debounce_Update(Debouncer *db, bool raw_input) {
     }
 }
 
+// Bit-Parallel Debouncer Bank (Vertical Counters)
+// A Debouncer per input costs a load, compare, branch and store for every line,
+// every 10 ms. Here each input is one bit lane of a word, as a GPIO port reads
+// it. The 7-bit counter is stored "vertically": plane[b] holds bit b of every
+// lane's counter. The integrator and hysteresis then run for the whole word with
+// bitwise ops:
+//   - Saturation: up = raw & (c < MAX), down = ~raw & (c != 0)
+//   - +-1: bit b flips where all lower bits are 1 (up) or all 0 (down)
+//   - Compare with a constant K: walk the bits from the LSB, res = c_b & res where
+//     K has a 1, res = c_b | res where K has a 0 (one op per bit)
+//   - stable = (c >= HIGH) | (stable & ~(c <= LOW))
+// This is Debounce_Update() on every lane, bit for bit. One Debounce_Word
+// (7 planes + state) is 64 bytes for 64 inputs: one cache line.
+// -DDEBOUNCE_LANES_32 uses 32-bit words for MCUs without fast 64-bit ops.
+#define DEBOUNCE_BITS 7
+_Static_assert(COUNTER_MAX < (1 << DEBOUNCE_BITS), "COUNTER_MAX must fit in DEBOUNCE_BITS");
+
+#if defined(DEBOUNCE_LANES_32)
+typedef uint32_t debounce_lanes_t;
+#else
+typedef uint64_t debounce_lanes_t;
+#endif
+#define DEBOUNCE_LANES ((int)(8 * sizeof(debounce_lanes_t)))
+
+typedef struct {
+    debounce_lanes_t plane[DEBOUNCE_BITS]; // plane[b] = bit b of each lane's counter
+    debounce_lanes_t stable;               // Filtered output, one bit per input
+} Debounce_Word;
+
+void Debounce_Word_Init(Debounce_Word *w) {
+    memset(w, 0, sizeof(*w));
+}
+
+// Lanes whose counter is >= k. k is a constant at every call site, so the loop
+// unrolls into one AND or OR per bit.
+static inline debounce_lanes_t Debounce_Word_Ge(const Debounce_Word *w, unsigned k) {
+    debounce_lanes_t res = ~(debounce_lanes_t)0; // Equal on no bits: c >= k holds
+    for (int b = 0; b < DEBOUNCE_BITS; b++)
+        res = ((k >> b) & 1u) ? (w->plane[b] & res) : (w->plane[b] | res);
+    return res;
+}
+
+void Debounce_Word_Update(Debounce_Word *w, debounce_lanes_t raw) {
+    // 1. Integrator with clamping at 0 and COUNTER_MAX
+    debounce_lanes_t nonzero = 0;
+    for (int b = 0; b < DEBOUNCE_BITS; b++) nonzero |= w->plane[b];
+    debounce_lanes_t up = raw & ~Debounce_Word_Ge(w, COUNTER_MAX);
+    debounce_lanes_t down = ~raw & nonzero;
+    for (int b = 0; b < DEBOUNCE_BITS; b++) {
+        debounce_lanes_t c = w->plane[b];
+        w->plane[b] = c ^ (up | down);
+        up &= c;    // Carry on: this bit was 1
+        down &= ~c; // Borrow on: this bit was 0
+    }
+
+    // 2. Hysteresis
+    debounce_lanes_t high = Debounce_Word_Ge(w, THRESHOLD_HIGH);
+    debounce_lanes_t low = ~Debounce_Word_Ge(w, THRESHOLD_LOW + 1);
+    w->stable = high | (w->stable & ~low);
+}
+
+// One call per 10 ms scan: raw[i] is the packed port for words[i]
+void Debounce_Bank_Update(Debounce_Word *words, const debounce_lanes_t *raw, size_t n_words) {
+    for (size_t i = 0; i < n_words; i++) Debounce_Word_Update(&words[i], raw[i]);
+}
+
+uint8_t Debounce_Word_Counter(const Debounce_Word *w, int lane) {
+    uint8_t c = 0;
+    for (int b = 0; b < DEBOUNCE_BITS; b++) c |= (uint8_t)(((w->plane[b] >> lane) & 1u) << b);
+    return c;
+}
+
+static inline bool Debounce_Word_State(const Debounce_Word *w, int lane) {
+    return (w->stable >> lane) & 1u;
+}
+
+// --- Bank test: random bounce traces and benchmark ---
+#define BANK_INPUTS 640 // 10 words of 64 (20 of 32)
+#define BANK_WORDS (BANK_INPUTS / DEBOUNCE_LANES)
+
+static uint32_t trace_seed = 12345;
+static uint32_t Trace_Rand(void) {
+    trace_seed = trace_seed * 1664525u + 1013904223u;
+    return trace_seed >> 8;
+}
+
+// Uniform in [0, n) for any 32-bit n (Trace_Rand() alone has 24 bits)
+static uint32_t Trace_RandBelow(uint32_t n) {
+    uint64_t r = ((uint64_t)Trace_Rand() << 24) | Trace_Rand();
+    return (uint32_t)(r % n);
+}
+
+static double Bench_NowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Each input holds a level for a random time and then switches. The raw reading
+// is wrong with 30% probability, which keeps counters in the hysteresis band.
+static void Trace_Step(bool *level, bool *raw_bool, debounce_lanes_t *raw_word) {
+    memset(raw_word, 0, BANK_WORDS * sizeof(debounce_lanes_t));
+    for (int i = 0; i < BANK_INPUTS; i++) {
+        if (Trace_Rand() % 200 == 0) level[i] = !level[i];
+        raw_bool[i] = (Trace_Rand() % 10 < 3) ? !level[i] : level[i];
+        if (raw_bool[i]) raw_word[i / DEBOUNCE_LANES] |= (debounce_lanes_t)1 << (i % DEBOUNCE_LANES);
+    }
+}
+
+// Event-Driven Debouncer (Edge Timestamps + One Timer)
+// Polling calls Debounce_Update() for every input every 10 ms, even on lines
+// that have not moved for hours. Between two edges the raw level is constant,
+// so the integrator is a straight line clamped at 0 / COUNTER_MAX, and the
+// hysteresis output after n ticks follows from the first and last counter value:
+//   - Rising:  last >= HIGH -> ON; else first <= LOW -> OFF; else unchanged
+//   - Falling: last <= LOW -> OFF; else first >= HIGH -> ON; else unchanged
+// Debounce_Lazy stores (tick, counter, state, level) and Debounce_Lazy_Advance()
+// applies any number of ticks in O(1). An output change is pending only while
+// the level pushes the counter towards the opposite threshold, and its tick is
+// known in advance. Pending changes sit in a min-heap indexed by line, and the
+// one hardware timer is armed for the heap top (Debounce_Events_NextDeadline).
+// The cost is O(log n) per edge or output change. Idle lines cost nothing.
+//
+// Tick k samples the input at k * DEBOUNCE_TICK_US, and an edge at time t is
+// seen by every tick with k * DEBOUNCE_TICK_US >= t, exactly like polling.
+//
+// Times and ticks are 64-bit. A 32-bit us timer wraps every ~71.6 min, and
+// 2^32 us is not a whole number of ticks, so ticks cannot be derived from the
+// raw reading. Debounce_Clock_Read() extends the hardware counter instead.
+#define DEBOUNCE_TICK_US 10000u
+#define DEBOUNCE_NO_DEADLINE UINT64_MAX
+
+// Extends a free-running 32-bit us timer to 64 bits. It must be read at least
+// once per wrap (e.g. from the timer overflow interrupt), so that an idle
+// system still counts the wraps.
+typedef struct {
+    uint64_t now_us;
+} Debounce_Clock;
+
+static inline uint64_t Debounce_Clock_Read(Debounce_Clock *c, uint32_t hw_us) {
+    c->now_us += (uint32_t)(hw_us - (uint32_t)c->now_us); // Wrap-safe elapsed time
+    return c->now_us;
+}
+
+typedef struct {
+    uint64_t tick;     // Counter and state are valid after this tick
+    uint8_t counter;
+    bool stable_state;
+    bool level;        // Raw input since the last edge
+} Debounce_Lazy;
+
+typedef void (*Debounce_ChangeFn)(void *ctx, uint16_t line, uint64_t tick, bool state);
+
+typedef struct {
+    uint16_t n;
+    Debounce_Lazy *lines;
+    uint64_t *deadline;  // Per line: tick of the pending output change
+    uint16_t *heap;      // Lines with a pending change, min-heap on deadline
+    int32_t *heap_pos;   // Per line: index in heap, -1 if not queued
+    uint16_t heap_len;
+    Debounce_ChangeFn on_change;
+    void *ctx;
+} Debounce_Events;
+
+void Debounce_Lazy_Advance(Debounce_Lazy *l, uint64_t tick) {
+    if (tick <= l->tick) return;
+    uint64_t n = tick - l->tick;
+    uint32_t c = l->counter, first, last;
+    l->tick = tick;
+    if (l->level) {
+        first = (c < COUNTER_MAX) ? c + 1 : COUNTER_MAX;
+        last = (n >= COUNTER_MAX - c) ? COUNTER_MAX : c + (uint32_t)n;
+        if (last >= THRESHOLD_HIGH) l->stable_state = true;
+        else if (first <= THRESHOLD_LOW) l->stable_state = false;
+    } else {
+        first = (c > 0) ? c - 1 : 0;
+        last = (n >= c) ? 0 : c - (uint32_t)n;
+        if (last <= THRESHOLD_LOW) l->stable_state = false;
+        else if (first >= THRESHOLD_HIGH) l->stable_state = true;
+    }
+    l->counter = (uint8_t)last;
+}
+
+// Tick of the next output change if the level stays as it is
+uint64_t Debounce_Lazy_Deadline(const Debounce_Lazy *l) {
+    if (l->level && !l->stable_state)
+        return l->tick + ((l->counter < THRESHOLD_HIGH) ? (uint64_t)(THRESHOLD_HIGH - l->counter) : 1u);
+    if (!l->level && l->stable_state)
+        return l->tick + ((l->counter > THRESHOLD_LOW) ? (uint64_t)(l->counter - THRESHOLD_LOW) : 1u);
+    return DEBOUNCE_NO_DEADLINE;
+}
+
+static void Debounce_Heap_Swap(Debounce_Events *ev, int i, int j) {
+    uint16_t a = ev->heap[i], b = ev->heap[j];
+    ev->heap[i] = b; ev->heap_pos[b] = i;
+    ev->heap[j] = a; ev->heap_pos[a] = j;
+}
+
+static void Debounce_Heap_Fix(Debounce_Events *ev, int i) {
+    while (i > 0 && ev->deadline[ev->heap[i]] < ev->deadline[ev->heap[(i - 1) / 2]]) {
+        Debounce_Heap_Swap(ev, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    for (;;) {
+        int l = 2 * i + 1, m = i;
+        if (l < ev->heap_len && ev->deadline[ev->heap[l]] < ev->deadline[ev->heap[m]]) m = l;
+        if (l + 1 < ev->heap_len && ev->deadline[ev->heap[l + 1]] < ev->deadline[ev->heap[m]]) m = l + 1;
+        if (m == i) return;
+        Debounce_Heap_Swap(ev, i, m);
+        i = m;
+    }
+}
+
+// Queue, move or cancel the line's pending change after its state or level changed
+static void Debounce_Events_Schedule(Debounce_Events *ev, uint16_t line) {
+    uint64_t d = Debounce_Lazy_Deadline(&ev->lines[line]);
+    int32_t pos = ev->heap_pos[line];
+    ev->deadline[line] = d;
+    if (d == DEBOUNCE_NO_DEADLINE) {
+        if (pos < 0) return;
+        ev->heap_len--;
+        if (pos != ev->heap_len) {
+            Debounce_Heap_Swap(ev, pos, ev->heap_len);
+            Debounce_Heap_Fix(ev, pos);
+        }
+        ev->heap_pos[line] = -1;
+    } else if (pos < 0) {
+        ev->heap[ev->heap_len] = line;
+        ev->heap_pos[line] = ev->heap_len++;
+        Debounce_Heap_Fix(ev, ev->heap_len - 1);
+    } else {
+        Debounce_Heap_Fix(ev, pos);
+    }
+}
+
+// Storage is supplied by the caller (no malloc on the target): n entries each
+void Debounce_Events_Init(Debounce_Events *ev, uint16_t n, Debounce_Lazy *lines, uint64_t *deadline,
+                          uint16_t *heap, int32_t *heap_pos, Debounce_ChangeFn on_change, void *ctx) {
+    ev->n = n;
+    ev->lines = lines;
+    ev->deadline = deadline;
+    ev->heap = heap;
+    ev->heap_pos = heap_pos;
+    ev->heap_len = 0;
+    ev->on_change = on_change;
+    ev->ctx = ctx;
+    for (uint16_t i = 0; i < n; i++) {
+        lines[i] = (Debounce_Lazy){ 0, 0, false, false };
+        deadline[i] = DEBOUNCE_NO_DEADLINE;
+        heap_pos[i] = -1;
+    }
+}
+
+// Time (us) to arm the hardware timer for, or DEBOUNCE_NO_DEADLINE if idle.
+// A 32-bit compare register takes the low 32 bits; deadlines are at most
+// THRESHOLD_HIGH ticks ahead, far less than one timer wrap.
+uint64_t Debounce_Events_NextDeadline(const Debounce_Events *ev) {
+    if (ev->heap_len == 0) return DEBOUNCE_NO_DEADLINE;
+    return ev->deadline[ev->heap[0]] * DEBOUNCE_TICK_US;
+}
+
+// Fire every pending change up to and including 'tick', in deadline order
+void Debounce_Events_RunTicks(Debounce_Events *ev, uint64_t tick) {
+    while (ev->heap_len > 0 && ev->deadline[ev->heap[0]] <= tick) {
+        uint16_t line = ev->heap[0];
+        Debounce_Lazy_Advance(&ev->lines[line], ev->deadline[line]);
+        if (ev->on_change) ev->on_change(ev->ctx, line, ev->deadline[line], ev->lines[line].stable_state);
+        Debounce_Events_Schedule(ev, line);
+    }
+}
+
+// Timer ISR: 'now_us' is the time the timer fired
+void Debounce_Events_Timer(Debounce_Events *ev, uint64_t now_us) {
+    Debounce_Events_RunTicks(ev, now_us / DEBOUNCE_TICK_US);
+}
+
+// Edge ISR: raw input 'line' changed to 'level' at 'time_us'
+void Debounce_Events_Edge(Debounce_Events *ev, uint16_t line, uint64_t time_us, bool level) {
+    uint64_t before = (time_us == 0) ? 0 : (time_us - 1) / DEBOUNCE_TICK_US; // Last tick that did not see it
+    Debounce_Events_RunTicks(ev, before); // Changes that happened before this edge fire first
+    Debounce_Lazy *l = &ev->lines[line];
+    Debounce_Lazy_Advance(l, before);
+    if (l->level == level) return;
+    l->level = level;
+    Debounce_Events_Schedule(ev, line);
+}
+
+// Output at 'time_us' for any line, without waiting for a timer
+bool Debounce_Events_Query(Debounce_Events *ev, uint16_t line, uint64_t time_us) {
+    Debounce_Lazy_Advance(&ev->lines[line], time_us / DEBOUNCE_TICK_US);
+    return ev->lines[line].stable_state;
+}
+
+// --- Event test: bounce traces, polled reference, CPU per simulated second ---
+typedef struct {
+    uint32_t time_us;
+    uint16_t line;
+    uint8_t level;
+} Edge_Event;
+
+typedef struct {
+    uint64_t tick;
+    uint16_t line;
+    uint8_t state;
+} Change_Event;
+
+typedef struct {
+    Change_Event *log;
+    size_t count;
+} Change_Log;
+
+static void Change_Record(void *ctx, uint16_t line, uint64_t tick, bool state) {
+    Change_Log *cl = ctx;
+    cl->log[cl->count++] = (Change_Event){ tick, line, state };
+}
+
+static int Edge_Compare(const void *a, const void *b) {
+    const Edge_Event *x = a, *y = b;
+    if (x->time_us != y->time_us) return x->time_us < y->time_us ? -1 : 1;
+    return (int)x->line - (int)y->line;
+}
+
+static int Change_Compare(const void *a, const void *b) {
+    const Change_Event *x = a, *y = b;
+    if (x->tick != y->tick) return x->tick < y->tick ? -1 : 1;
+    return (int)x->line - (int)y->line;
+}
+
+// Switch actuations on every line: the level toggles at random intervals with a
+// mean of 1/rate s, and each toggle bounces 0-5 times over up to ~16 ms
+static size_t Trace_Bounce(Edge_Event *edges, size_t cap, int lines, double rate_hz, uint32_t duration_us) {
+    size_t n = 0;
+    uint32_t mean_gap = (uint32_t)(1e6 / rate_hz);
+    for (int line = 0; line < lines; line++) {
+        bool level = false;
+        uint64_t t = Trace_RandBelow(mean_gap);
+        while (t + 20000 < duration_us && n + 12 <= cap) {
+            level = !level;
+            edges[n++] = (Edge_Event){ (uint32_t)t, (uint16_t)line, level };
+            int bounces = (int)(Trace_Rand() % 6);
+            for (int b = 0; b < bounces; b++) {
+                t += 1000 + Trace_Rand() % 2000;
+                edges[n++] = (Edge_Event){ (uint32_t)t, (uint16_t)line, !level };
+                t += 200 + Trace_Rand() % 1000;
+                edges[n++] = (Edge_Event){ (uint32_t)t, (uint16_t)line, level };
+            }
+            t += 20000 + mean_gap / 2 + Trace_RandBelow(mean_gap);
+        }
+    }
+    qsort(edges, n, sizeof(Edge_Event), Edge_Compare);
+    return n;
+}
+
+// Polled reference vs event-driven run of one trace. Trace times are relative
+// to 'start_us'. The event side sees them as 32-bit hardware timer readings
+// extended by Debounce_Clock, so a start just below 2^32 us crosses the wrap.
+// Returns true if both give the same output changes at the same ticks and the
+// same final integrator state.
+static Debouncer wrap_ref[BANK_INPUTS];
+static bool wrap_level[BANK_INPUTS];
+static Debounce_Lazy lazy[BANK_INPUTS];
+static uint64_t deadline[BANK_INPUTS];
+static uint16_t heap[BANK_INPUTS];
+static int32_t heap_pos[BANK_INPUTS];
+
+static bool Event_VsPolled(const Edge_Event *edges, size_t n_edges, uint64_t start_us, uint32_t sim_us,
+                           Change_Log *polled_log, Change_Log *event_log, double *t_polled, double *t_event) {
+    // Polled reference: sample every line at every tick
+    polled_log->count = 0;
+    for (int i = 0; i < BANK_INPUTS; i++) { Debounce_Init(&wrap_ref[i]); wrap_level[i] = false; }
+    size_t e = 0;
+    double t0 = Bench_NowSec();
+    for (uint64_t k = start_us / DEBOUNCE_TICK_US + 1; k <= (start_us + sim_us) / DEBOUNCE_TICK_US; k++) {
+        for (; e < n_edges && start_us + edges[e].time_us <= k * DEBOUNCE_TICK_US; e++)
+            wrap_level[edges[e].line] = edges[e].level;
+        for (int i = 0; i < BANK_INPUTS; i++) {
+            bool before = wrap_ref[i].stable_state;
+            Debounce_Update(&wrap_ref[i], wrap_level[i]);
+            if (wrap_ref[i].stable_state != before) Change_Record(polled_log, (uint16_t)i, k, wrap_ref[i].stable_state);
+        }
+    }
+    *t_polled = Bench_NowSec() - t0;
+
+    // Event-driven: edges and timer expiries in time order. The timer fires
+    // before an edge if its 32-bit compare value is earlier (wrap-safe).
+    Debounce_Events ev;
+    Debounce_Clock clk = { start_us };
+    event_log->count = 0;
+    t0 = Bench_NowSec();
+    Debounce_Events_Init(&ev, BANK_INPUTS, lazy, deadline, heap, heap_pos, Change_Record, event_log);
+    for (e = 0; e < n_edges; e++) {
+        uint32_t hw_us = (uint32_t)(start_us + edges[e].time_us);
+        uint64_t d;
+        while ((d = Debounce_Events_NextDeadline(&ev)) != DEBOUNCE_NO_DEADLINE && (int32_t)((uint32_t)d - hw_us) < 0)
+            Debounce_Events_Timer(&ev, Debounce_Clock_Read(&clk, (uint32_t)d));
+        Debounce_Events_Edge(&ev, edges[e].line, Debounce_Clock_Read(&clk, hw_us), edges[e].level);
+    }
+    uint64_t end_us = Debounce_Clock_Read(&clk, (uint32_t)(start_us + sim_us));
+    Debounce_Events_Timer(&ev, end_us);
+    *t_event = Bench_NowSec() - t0;
+
+    bool same = polled_log->count == event_log->count && end_us == start_us + sim_us;
+    qsort(event_log->log, event_log->count, sizeof(Change_Event), Change_Compare);
+    for (size_t i = 0; same && i < polled_log->count; i++)
+        same = Change_Compare(&polled_log->log[i], &event_log->log[i]) == 0 &&
+               polled_log->log[i].state == event_log->log[i].state;
+    for (int i = 0; same && i < BANK_INPUTS; i++)
+        same = Debounce_Events_Query(&ev, (uint16_t)i, end_us) == wrap_ref[i].stable_state &&
+               lazy[i].counter == wrap_ref[i].counter;
+    return same;
+}
+
+static volatile uint32_t bench_sink;
+
 int main() {
     Debouncer db;
     Debounce_Init(&db);
@@ -81,6 +498,104 @@ int main() {
     }
     printf("After noisy drop -> Counter: %d | State: %d (Expect 1 still)\n", 
            db.counter, db.stable_state);
-           
+
+    printf("\n--- Test 4: Bit-Parallel Bank vs Debounce_Update (%d inputs, %d-bit lanes) ---\n", BANK_INPUTS, DEBOUNCE_LANES);
+    #define VERIFY_TICKS 100000
+    static Debouncer ref[BANK_INPUTS];
+    static Debounce_Word bank[BANK_WORDS];
+    static bool level[BANK_INPUTS], raw_bool[BANK_INPUTS];
+    static debounce_lanes_t raw_word[BANK_WORDS];
+    for (int i = 0; i < BANK_INPUTS; i++) Debounce_Init(&ref[i]);
+    for (int w = 0; w < BANK_WORDS; w++) Debounce_Word_Init(&bank[w]);
+    long mismatches = 0, state_changes = 0;
+    for (int t = 0; t < VERIFY_TICKS; t++) {
+        Trace_Step(level, raw_bool, raw_word);
+        Debounce_Bank_Update(bank, raw_word, BANK_WORDS);
+        for (int i = 0; i < BANK_INPUTS; i++) {
+            bool before = ref[i].stable_state;
+            Debounce_Update(&ref[i], raw_bool[i]);
+            state_changes += (ref[i].stable_state != before);
+            const Debounce_Word *w = &bank[i / DEBOUNCE_LANES];
+            if (Debounce_Word_Counter(w, i % DEBOUNCE_LANES) != ref[i].counter ||
+                Debounce_Word_State(w, i % DEBOUNCE_LANES) != ref[i].stable_state) mismatches++;
+        }
+    }
+    printf("%d ticks, %ld output changes: %s (%ld mismatches)\n", VERIFY_TICKS, state_changes,
+           mismatches ? "MISMATCH!" : "IDENTICAL", mismatches);
+
+    // Benchmark on pre-recorded scans, so trace generation is not timed
+    #define BENCH_SCANS 64
+    #define BENCH_REPEAT 2000
+    static bool scan_bool[BENCH_SCANS][BANK_INPUTS];
+    static debounce_lanes_t scan_word[BENCH_SCANS][BANK_WORDS];
+    for (int k = 0; k < BENCH_SCANS; k++) Trace_Step(level, scan_bool[k], scan_word[k]);
+    double t0 = Bench_NowSec();
+    for (int r = 0; r < BENCH_REPEAT; r++)
+        for (int k = 0; k < BENCH_SCANS; k++)
+            for (int i = 0; i < BANK_INPUTS; i++) Debounce_Update(&ref[i], scan_bool[k][i]);
+    double t_struct = Bench_NowSec() - t0;
+    t0 = Bench_NowSec();
+    for (int r = 0; r < BENCH_REPEAT; r++)
+        for (int k = 0; k < BENCH_SCANS; k++) Debounce_Bank_Update(bank, scan_word[k], BANK_WORDS);
+    double t_bank = Bench_NowSec() - t0;
+    bench_sink = ref[0].counter + (uint32_t)bank[0].stable;
+    double updates = (double)BENCH_REPEAT * BENCH_SCANS * BANK_INPUTS;
+    printf("Debouncer array: %.0f inputs/us | Bit-parallel bank: %.0f inputs/us (%.1fx)\n",
+           updates / t_struct * 1e-6, updates / t_bank * 1e-6, t_struct / t_bank);
+
+    printf("\n--- Test 5: Event-Driven Debouncer vs Polling (%d inputs) ---\n", BANK_INPUTS);
+    #define EVENT_SIM_S 120
+    #define EVENT_EDGE_CAP 8000000
+    const uint32_t sim_us = EVENT_SIM_S * 1000000u;
+    Edge_Event *edges = malloc(EVENT_EDGE_CAP * sizeof(Edge_Event));
+    Change_Log polled_log = { malloc(EVENT_EDGE_CAP * sizeof(Change_Event)), 0 };
+    Change_Log event_log = { malloc(EVENT_EDGE_CAP * sizeof(Change_Event)), 0 };
+    if (!edges || !polled_log.log || !event_log.log) return 1;
+
+    printf("%12s %10s %10s %12s %14s %14s %10s\n", "Toggles/s", "Edges", "Changes", "Result",
+           "Polled us/s", "Event us/s", "Speedup");
+    const double rates[5] = { 0.001, 0.01, 0.1, 1.0, 10.0 }; // Switch actuations per line per second
+    for (int r = 0; r < 5; r++) {
+        size_t n_edges = Trace_Bounce(edges, EVENT_EDGE_CAP, BANK_INPUTS, rates[r], sim_us);
+
+        double t_polled, t_event;
+        bool same = Event_VsPolled(edges, n_edges, 0, sim_us, &polled_log, &event_log, &t_polled, &t_event);
+
+        printf("%12.3f %10zu %10zu %12s %14.1f %14.1f %9.1fx\n", rates[r], n_edges, polled_log.count,
+               same ? "IDENTICAL" : "MISMATCH!", t_polled / EVENT_SIM_S * 1e6, t_event / EVENT_SIM_S * 1e6,
+               t_polled / t_event);
+    }
+
+    // The 32-bit us timer wraps every ~71.6 min: run a trace that starts 60 s
+    // before the wrap, then leave every line idle for 5 hours (4 more wraps,
+    // seen only by the overflow interrupt) and query them
+    printf("\n--- Test 6: 32-bit Timer Wrap (%d inputs) ---\n", BANK_INPUTS);
+    {
+        const uint64_t start_us = (1ull << 32) - 60000000u;
+        size_t n_edges = Trace_Bounce(edges, EVENT_EDGE_CAP, BANK_INPUTS, 1.0, sim_us);
+        double t_polled, t_event;
+        bool same = Event_VsPolled(edges, n_edges, start_us, sim_us, &polled_log, &event_log, &t_polled, &t_event);
+        printf("%u s across the wrap, %zu edges, %zu changes: %s\n", (unsigned)EVENT_SIM_S, n_edges,
+               polled_log.count, same ? "IDENTICAL" : "MISMATCH!");
+
+        Debounce_Clock clk = { start_us + sim_us };
+        uint64_t idle_end = start_us + sim_us + 5ull * 3600u * 1000000u;
+        for (uint64_t t = clk.now_us; t < idle_end; t += 1u << 31) Debounce_Clock_Read(&clk, (uint32_t)t);
+        uint64_t now_us = Debounce_Clock_Read(&clk, (uint32_t)idle_end);
+        bool idle_same = now_us == idle_end;
+        for (int i = 0; i < BANK_INPUTS; i++) {
+            for (int k = 0; k <= COUNTER_MAX; k++) Debounce_Update(&wrap_ref[i], wrap_level[i]); // Saturates
+            Debounce_Lazy_Advance(&lazy[i], now_us / DEBOUNCE_TICK_US); // What Debounce_Events_Query() does
+            idle_same = idle_same && lazy[i].stable_state == wrap_ref[i].stable_state &&
+                        lazy[i].counter == wrap_ref[i].counter;
+        }
+        printf("Then 5 h idle (%llu wraps total), query every line: %s\n",
+               (unsigned long long)(now_us >> 32), idle_same ? "IDENTICAL" : "MISMATCH!");
+    }
+
+    free(edges);
+    free(polled_log.log);
+    free(event_log.log);
+
     return 0;
 }
\ No newline at end of file
@@ -1,5 +1,15 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#include "../FSM_Generator/Fsm_Print.h"
 
 // State Definitions
 typedef enum {
@@ -104,12 +114,718 @@ void Controller_Run(ChargeController *cc, Sensors *sens, ChargerCmd *cmd) {
         case STATE_FAULT:
             cmd->cmd_current_limit = 0.0f;
             cmd->cmd_voltage_limit = 0.0f;
-            printf("!! FAULT ACTIVE !!\n");
+            Fsm_Printf("!! FAULT ACTIVE !!\n");
             // Stay here forever (latched fault)
             break;
     }
 }
 
+// Generated Charger FSM (FSM_Generator/Fsm_Gen.h)
+// The same charger written as a declarative description. Fsm_Gen.h turns it into
+// Charger_Step_Switch() and Charger_Step_Table(), and checks at compile time that
+// every state is reachable and that only COMPLETE and FAULT are dead ends.
+// Rows follow Controller_Run(): the FSM_ANY over-temperature rule fires before
+// the state's 'during' output, exactly like the global safety check.
+typedef struct {
+    const Sensors *sens;
+    ChargerCmd *cmd;
+} Charger_Io;
+
+#define CHG_OUTPUT(i, v) (ctx->cmd->cmd_current_limit = (i), ctx->cmd->cmd_voltage_limit = (v))
+
+#define FSM_NAME     Charger
+#define FSM_CTX      Charger_Io
+#define FSM_INITIAL  CHG_IDLE
+#define FSM_DISPATCH FSM_DISPATCH_SWITCH // Profiled: see the benchmark in main()
+#define FSM_STATES(S) \
+    S(CHG_IDLE,      FSM_NORMAL,   FSM_NONE, CHG_OUTPUT(0.0f, 0.0f),  FSM_NONE) \
+    S(CHG_PRECHARGE, FSM_NORMAL,   FSM_NONE, CHG_OUTPUT(0.5f, 4.2f),  FSM_NONE) \
+    S(CHG_CC,        FSM_NORMAL,   FSM_NONE, CHG_OUTPUT(10.0f, 4.2f), FSM_NONE) \
+    S(CHG_CV,        FSM_NORMAL,   FSM_NONE, CHG_OUTPUT(10.0f, 4.2f), FSM_NONE) \
+    S(CHG_COMPLETE,  FSM_TERMINAL, FSM_NONE, CHG_OUTPUT(0.0f, 0.0f),  FSM_NONE) \
+    S(CHG_FAULT,     FSM_TERMINAL, FSM_NONE, (CHG_OUTPUT(0.0f, 0.0f), Fsm_Printf("!! FAULT ACTIVE !!\n")), FSM_NONE)
+#define FSM_EVENTS(E) E(CHG_EV_TICK)
+#define FSM_TRANSITIONS(T) \
+    T(FSM_ANY,       CHG_EV_TICK, ctx->sens->temp_c > TEMP_MAX,                                      FSM_NONE, CHG_FAULT) \
+    T(CHG_IDLE,      CHG_EV_TICK, ctx->sens->charger_connected && ctx->sens->voltage < V_PRECHARGE_EXIT, FSM_NONE, CHG_PRECHARGE) \
+    T(CHG_IDLE,      CHG_EV_TICK, ctx->sens->charger_connected,                                      FSM_NONE, CHG_CC) \
+    T(CHG_PRECHARGE, CHG_EV_TICK, ctx->sens->voltage >= V_PRECHARGE_EXIT,                            FSM_NONE, CHG_CC) \
+    T(CHG_CC,        CHG_EV_TICK, ctx->sens->voltage >= V_TARGET,                                    FSM_NONE, CHG_CV) \
+    T(CHG_CV,        CHG_EV_TICK, ctx->sens->current < I_TERMINATION,                                FSM_NONE, CHG_COMPLETE)
+#include "../FSM_Generator/Fsm_Gen.h"
+
+// Batched Fleet Controller (SoA + Transition Table)
+// Planning runs simulate 10k+ packs. Controller_Run() per pack is a switch with
+// hard-to-predict branches once the fleet is spread over all states. The batch
+// version keeps the fleet in SoA arrays and replaces the switch by data:
+//   - Guards: six comparisons per pack (hot, connected, v < 3.0, v >= 3.0,
+//     v >= 4.2, i < 0.5), packed into a 6-bit guard code. They are separate bits
+//     because NaN fails both v < 3.0 and v >= 3.0, exactly as in the switch.
+//   - charge_transitions[] lists the transitions (from, required guards, to) in
+//     priority order. Charge_Tables_Init() expands it into a dense
+//     charge_next[state][guard] table.
+//   - The command depends only on the state after the temperature override, so
+//     it comes from charge_cmd_table[] (CmdTable).
+// The AVX2 kernel evaluates all guards for 8 packs with vector compares,
+// spreads the 8-bit compare masks into per-pack bytes, and looks up the
+// commands with one permute per output. Every pack runs the same code
+// whatever its state, so the packs do not need to be sorted by state.
+// Results are bit-identical to Controller_Run(). The only difference is the
+// FAULT printf: the batch counts FAULT packs and returns the number of lines
+// Controller_Run() would have printed.
+
+#define CHARGE_STATE_COUNT (STATE_FAULT + 1)
+#define CHARGE_STATE_ANY   0xFF
+
+enum {
+    G_HOT           = 1 << 0, // temp_c > TEMP_MAX
+    G_CONNECTED     = 1 << 1, // charger_connected != 0
+    G_V_LT_PRE      = 1 << 2, // voltage < V_PRECHARGE_EXIT
+    G_V_GE_PRE      = 1 << 3, // voltage >= V_PRECHARGE_EXIT
+    G_V_GE_TARGET   = 1 << 4, // voltage >= V_TARGET
+    G_I_LT_TERM     = 1 << 5, // current < I_TERMINATION
+    CHARGE_GUARD_COUNT = 1 << 6
+};
+
+typedef struct {
+    uint8_t from;     // ChargeState_t or CHARGE_STATE_ANY
+    uint8_t required; // Guard bits that must all be set
+    uint8_t to;
+} Charge_Transition;
+
+// First match wins; no match keeps the state
+static const Charge_Transition charge_transitions[] = {
+    { CHARGE_STATE_ANY, G_HOT,                    STATE_FAULT },     // Global safety check
+    { STATE_IDLE,       G_CONNECTED | G_V_LT_PRE, STATE_PRECHARGE },
+    { STATE_IDLE,       G_CONNECTED,              STATE_CC },
+    { STATE_PRECHARGE,  G_V_GE_PRE,               STATE_CC },
+    { STATE_CC,         G_V_GE_TARGET,            STATE_CV },
+    { STATE_CV,         G_I_LT_TERM,              STATE_COMPLETE },
+};
+
+static const ChargerCmd charge_cmd_table[CHARGE_STATE_COUNT] = {
+    [STATE_IDLE]      = { 0.0f,  0.0f },
+    [STATE_PRECHARGE] = { 0.5f,  4.2f },
+    [STATE_CC]        = { 10.0f, 4.2f },
+    [STATE_CV]        = { 10.0f, 4.2f },
+    [STATE_COMPLETE]  = { 0.0f,  0.0f },
+    [STATE_FAULT]     = { 0.0f,  0.0f },
+};
+
+static uint8_t charge_next[CHARGE_STATE_COUNT][CHARGE_GUARD_COUNT];
+static uint64_t guard_spread[256]; // Byte k = bit k of the index
+
+void Charge_Tables_Init(void) {
+    for (int st = 0; st < CHARGE_STATE_COUNT; st++)
+        for (int g = 0; g < CHARGE_GUARD_COUNT; g++) {
+            charge_next[st][g] = (uint8_t)st;
+            for (size_t r = 0; r < sizeof(charge_transitions) / sizeof(charge_transitions[0]); r++) {
+                const Charge_Transition *t = &charge_transitions[r];
+                if ((t->from == st || t->from == CHARGE_STATE_ANY) && (g & t->required) == t->required) {
+                    charge_next[st][g] = t->to;
+                    break;
+                }
+            }
+        }
+    for (int m = 0; m < 256; m++) {
+        guard_spread[m] = 0;
+        for (int k = 0; k < 8; k++) guard_spread[m] |= (uint64_t)((m >> k) & 1) << (8 * k);
+    }
+}
+
+typedef struct {
+    size_t n;
+    uint8_t *state;
+    float *voltage, *current, *temp_c;
+    int32_t *charger_connected;
+    float *cmd_current_limit, *cmd_voltage_limit;
+} Charge_Fleet;
+
+bool Fleet_Init(Charge_Fleet *f, size_t n) {
+    f->n = n;
+    f->state = calloc(n, 1);
+    f->voltage = calloc(n, sizeof(float));
+    f->current = calloc(n, sizeof(float));
+    f->temp_c = calloc(n, sizeof(float));
+    f->charger_connected = calloc(n, sizeof(int32_t));
+    f->cmd_current_limit = calloc(n, sizeof(float));
+    f->cmd_voltage_limit = calloc(n, sizeof(float));
+    return f->state && f->voltage && f->current && f->temp_c && f->charger_connected &&
+           f->cmd_current_limit && f->cmd_voltage_limit; // Every pack starts in STATE_IDLE (0)
+}
+
+void Fleet_Free(Charge_Fleet *f) {
+    free(f->state);
+    free(f->voltage);
+    free(f->current);
+    free(f->temp_c);
+    free(f->charger_connected);
+    free(f->cmd_current_limit);
+    free(f->cmd_voltage_limit);
+}
+
+static inline unsigned Charge_Guards(float v, float i, float t, int32_t connected) {
+    return (t > TEMP_MAX ? G_HOT : 0u) | (connected ? G_CONNECTED : 0u) |
+           (v < V_PRECHARGE_EXIT ? G_V_LT_PRE : 0u) | (v >= V_PRECHARGE_EXIT ? G_V_GE_PRE : 0u) |
+           (v >= V_TARGET ? G_V_GE_TARGET : 0u) | (i < I_TERMINATION ? G_I_LT_TERM : 0u);
+}
+
+// One pack through the tables; returns 1 if it ran in FAULT
+static inline size_t Fleet_StepLane(Charge_Fleet *f, size_t k) {
+    unsigned g = Charge_Guards(f->voltage[k], f->current[k], f->temp_c[k], f->charger_connected[k]);
+    unsigned st = f->state[k];
+    unsigned cmd_st = (g & G_HOT) ? STATE_FAULT : st;
+    f->cmd_current_limit[k] = charge_cmd_table[cmd_st].cmd_current_limit;
+    f->cmd_voltage_limit[k] = charge_cmd_table[cmd_st].cmd_voltage_limit;
+    f->state[k] = charge_next[st][g];
+    return cmd_st == STATE_FAULT;
+}
+
+typedef size_t (*Fleet_RunFn)(Charge_Fleet *f, size_t begin, size_t end);
+
+size_t Controller_Run_Batch_Scalar(Charge_Fleet *f, size_t begin, size_t end) {
+    size_t faults = 0;
+    for (size_t k = begin; k < end; k++) faults += Fleet_StepLane(f, k);
+    return faults;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2,popcnt")))
+static size_t Controller_Run_Batch_Avx2(Charge_Fleet *f, size_t begin, size_t end) {
+    const __m256 t_max = _mm256_set1_ps(TEMP_MAX), v_pre = _mm256_set1_ps(V_PRECHARGE_EXIT);
+    const __m256 v_tgt = _mm256_set1_ps(V_TARGET), i_term = _mm256_set1_ps(I_TERMINATION);
+    const __m256 cmd_i = _mm256_setr_ps(charge_cmd_table[0].cmd_current_limit, charge_cmd_table[1].cmd_current_limit,
+                                        charge_cmd_table[2].cmd_current_limit, charge_cmd_table[3].cmd_current_limit,
+                                        charge_cmd_table[4].cmd_current_limit, charge_cmd_table[5].cmd_current_limit, 0.0f, 0.0f);
+    const __m256 cmd_v = _mm256_setr_ps(charge_cmd_table[0].cmd_voltage_limit, charge_cmd_table[1].cmd_voltage_limit,
+                                        charge_cmd_table[2].cmd_voltage_limit, charge_cmd_table[3].cmd_voltage_limit,
+                                        charge_cmd_table[4].cmd_voltage_limit, charge_cmd_table[5].cmd_voltage_limit, 0.0f, 0.0f);
+    const __m256i fault = _mm256_set1_epi32(STATE_FAULT);
+    size_t faults = 0, k = begin;
+    for (; k + 8 <= end; k += 8) {
+        __m256 v = _mm256_loadu_ps(f->voltage + k), t = _mm256_loadu_ps(f->temp_c + k);
+        __m256 i = _mm256_loadu_ps(f->current + k);
+        __m256i c = _mm256_loadu_si256((const __m256i *)(f->charger_connected + k));
+        unsigned m_hot = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(t, t_max, _CMP_GT_OQ));
+        unsigned m_conn = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(c, _mm256_setzero_si256()))) & 0xFFu;
+        uint64_t g = guard_spread[m_hot] | guard_spread[m_conn] << 1 |
+                     guard_spread[_mm256_movemask_ps(_mm256_cmp_ps(v, v_pre, _CMP_LT_OQ))] << 2 |
+                     guard_spread[_mm256_movemask_ps(_mm256_cmp_ps(v, v_pre, _CMP_GE_OQ))] << 3 |
+                     guard_spread[_mm256_movemask_ps(_mm256_cmp_ps(v, v_tgt, _CMP_GE_OQ))] << 4 |
+                     guard_spread[_mm256_movemask_ps(_mm256_cmp_ps(i, i_term, _CMP_LT_OQ))] << 5;
+
+        // Command state: FAULT where hot, else the current state (byte-wise select)
+        uint64_t st;
+        memcpy(&st, f->state + k, 8);
+        uint64_t hot_bytes = guard_spread[m_hot] * 0xFFu;
+        uint64_t cmd_st = (st & ~hot_bytes) | (hot_bytes & (0x0101010101010101ull * STATE_FAULT));
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)cmd_st));
+        _mm256_storeu_ps(f->cmd_current_limit + k, _mm256_permutevar8x32_ps(cmd_i, idx));
+        _mm256_storeu_ps(f->cmd_voltage_limit + k, _mm256_permutevar8x32_ps(cmd_v, idx));
+        faults += (size_t)__builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(idx, fault))));
+
+        uint8_t next[8];
+        for (int l = 0; l < 8; l++) next[l] = charge_next[(st >> (8 * l)) & 0xFF][(g >> (8 * l)) & 0xFF];
+        memcpy(f->state + k, next, 8);
+    }
+    for (; k < end; k++) faults += Fleet_StepLane(f, k); // Inlined, stays VEX
+    return faults;
+}
+#endif
+
+Fleet_RunFn Controller_Run_Batch = Controller_Run_Batch_Scalar;
+const char *fleet_batch_impl = "Scalar";
+
+void Controller_Batch_Init(void) {
+    Charge_Tables_Init();
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        Controller_Run_Batch = Controller_Run_Batch_Avx2;
+        fleet_batch_impl = "AVX2";
+    }
+#endif
+}
+
+// --- Fleet plant: a simple charger + cell response to drive the controllers ---
+// Terminal voltage = OCV + I * R. The charger delivers the commanded current
+// unless that would exceed the voltage limit (then it holds the limit: CV taper).
+// Packs plug in at staggered ticks; a few see an over-temperature event.
+#define PLANT_R_OHM 0.01f
+
+typedef struct {
+    float *ocv, *ocv_per_amp; // Per-tick OCV rise per ampere (capacity)
+    float *ambient;
+    uint32_t *connect_tick, *fault_tick;
+} Fleet_Plant;
+
+static uint32_t plant_seed = 12345;
+static float Plant_Rand(float lo, float hi) {
+    plant_seed = plant_seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (float)(plant_seed >> 8) / 16777216.0f;
+}
+
+bool Fleet_Plant_Init(Fleet_Plant *p, size_t n, uint32_t ticks) {
+    p->ocv = malloc(n * sizeof(float));
+    p->ocv_per_amp = malloc(n * sizeof(float));
+    p->ambient = malloc(n * sizeof(float));
+    p->connect_tick = malloc(n * sizeof(uint32_t));
+    p->fault_tick = malloc(n * sizeof(uint32_t));
+    if (!p->ocv || !p->ocv_per_amp || !p->ambient || !p->connect_tick || !p->fault_tick) return false;
+    for (size_t k = 0; k < n; k++) {
+        p->ocv[k] = Plant_Rand(2.8f, 3.9f);
+        p->ocv_per_amp[k] = Plant_Rand(0.5e-4f, 2.0e-4f);
+        p->ambient[k] = Plant_Rand(15.0f, 40.0f);
+        p->connect_tick[k] = (uint32_t)Plant_Rand(0.0f, ticks / 4.0f);
+        p->fault_tick[k] = (Plant_Rand(0.0f, 1.0f) < 0.002f) ? (uint32_t)Plant_Rand(0.0f, (float)ticks) : UINT32_MAX;
+    }
+    return true;
+}
+
+void Fleet_Plant_Free(Fleet_Plant *p) {
+    free(p->ocv);
+    free(p->ocv_per_amp);
+    free(p->ambient);
+    free(p->connect_tick);
+    free(p->fault_tick);
+}
+
+// Apply the commands of tick 'tick' and produce the sensors for the next one
+void Fleet_Plant_Step(const Fleet_Plant *p, Charge_Fleet *f, size_t begin, size_t end, uint32_t tick) {
+    for (size_t k = begin; k < end; k++) {
+        if (tick >= p->connect_tick[k]) f->charger_connected[k] = 1;
+        float i = f->cmd_current_limit[k], v_lim = f->cmd_voltage_limit[k];
+        float v = p->ocv[k] + i * PLANT_R_OHM;
+        if (v_lim > 0.0f && v > v_lim) {
+            i = (v_lim - p->ocv[k]) / PLANT_R_OHM;
+            if (i < 0.0f) i = 0.0f;
+            v = v_lim;
+        }
+        p->ocv[k] += i * p->ocv_per_amp[k];
+        f->voltage[k] = v;
+        f->current[k] = i;
+        f->temp_c[k] = (tick >= p->fault_tick[k]) ? 50.0f : p->ambient[k];
+    }
+}
+
+// Reference: Controller_Run() per pack on the same SoA data
+size_t Fleet_Run_Reference(ChargeController *cc, Charge_Fleet *f, size_t begin, size_t end) {
+    size_t faults = 0;
+    for (size_t k = begin; k < end; k++) {
+        Sensors sens = { f->voltage[k], f->current[k], f->temp_c[k], f->charger_connected[k] };
+        ChargerCmd cmd;
+        faults += (cc[k].state == STATE_FAULT || sens.temp_c > TEMP_MAX);
+        Controller_Run(&cc[k], &sens, &cmd);
+        f->cmd_current_limit[k] = cmd.cmd_current_limit;
+        f->cmd_voltage_limit[k] = cmd.cmd_voltage_limit;
+    }
+    return faults;
+}
+
+// --- Partitioned multi-threaded mode: packs are independent, so each thread
+// owns a contiguous range (aligned to 64 packs, so no cache line is shared)
+// and runs plant + controller for every tick without synchronization ---
+#define FLEET_MAX_THREADS 16
+
+typedef struct {
+    Charge_Fleet *fleet;
+    const Fleet_Plant *plant;
+    size_t begin, end;
+    uint32_t ticks;
+    size_t faults;
+} Fleet_Partition;
+
+static void *Fleet_PartitionWorker(void *arg) {
+    Fleet_Partition *part = (Fleet_Partition *)arg;
+    part->faults = 0;
+    for (uint32_t tick = 0; tick < part->ticks; tick++) {
+        part->faults += Controller_Run_Batch(part->fleet, part->begin, part->end);
+        Fleet_Plant_Step(part->plant, part->fleet, part->begin, part->end, tick);
+    }
+    return NULL;
+}
+
+size_t Fleet_Run_Parallel(Charge_Fleet *f, const Fleet_Plant *p, uint32_t ticks, int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > FLEET_MAX_THREADS) threads = FLEET_MAX_THREADS;
+
+    Fleet_Partition parts[FLEET_MAX_THREADS];
+    pthread_t tid[FLEET_MAX_THREADS];
+    bool started[FLEET_MAX_THREADS] = { false };
+    // Ceiling share, rounded up to 64 packs: the partitions always cover the fleet
+    size_t per_part = ((f->n + (size_t)threads - 1) / (size_t)threads + 63) & ~(size_t)63;
+
+    for (int t = 0; t < threads; t++) {
+        size_t begin = (size_t)t * per_part, end = begin + per_part;
+        parts[t] = (Fleet_Partition){ f, p, begin < f->n ? begin : f->n, end < f->n ? end : f->n, ticks, 0 };
+        // The calling thread takes partition 0 itself
+        if (t > 0) started[t] = pthread_create(&tid[t], NULL, Fleet_PartitionWorker, &parts[t]) == 0;
+    }
+    Fleet_PartitionWorker(&parts[0]);
+    // A partition whose thread could not be created runs on the calling thread
+    for (int t = 1; t < threads; t++)
+        if (!started[t]) Fleet_PartitionWorker(&parts[t]);
+
+    size_t faults = parts[0].faults;
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(tid[t], NULL);
+        faults += parts[t].faults;
+    }
+    return faults;
+}
+
+// Charging Profile Simulator (Equivalent-Circuit Cell Model)
+// Capacity planning runs whole charge sessions: Controller_Run() is stepped at
+// 1 ms resolution against a simulated cell and charger.
+//   - Cell: OCV(SOC) in series with R0 and two RC pairs (2RC Thevenin model).
+//     The RC pairs use the exact zero-order-hold discretization.
+//   - OCV: the Day 4 LUT shape (3.00..3.60 V over 0..100 % SOC) stretched to
+//     3.0..4.2 V, so precharge, CC and CV happen at this controller's
+//     thresholds. Linear between the points; the end segments extrapolate.
+//   - Thermal: one lumped mass heated by I * (V - OCV) and cooled through R_th.
+//   - Charger: delivers the commanded current unless the terminal voltage would
+//     exceed the voltage limit; then it holds the limit (CV taper).
+// Plant state is double: hours of 1 ms SOC increments would vanish in float.
+#define SIM_DT_S        0.001
+#define SIM_OCV_POINTS  5
+static const double sim_ocv_soc[SIM_OCV_POINTS] = { 0.00, 0.30, 0.60, 0.80, 1.00 };
+static const double sim_ocv_v[SIM_OCV_POINTS]   = { 3.00, 3.40, 3.50, 3.60, 4.20 };
+
+typedef struct {
+    double capacity_ah, soc0;
+    double r0, r1, tau1, r2, tau2;  // Ohm, s
+    double r_th, c_th, t_ambient;   // K/W, J/K, degC
+    uint32_t connect_ms;            // Charger plugged in
+    uint32_t cooling_fail_ms;       // Cooling fails (R_th x4); UINT32_MAX = never
+    uint32_t horizon_ms;
+} Sim_Scenario;
+
+typedef struct {
+    double soc, v1, v2, temp;
+    double r0, a1, b1, a2, b2, k_soc; // Per-step constants: v' = a * v + b * I
+    double r_th, a_th, t_ambient;
+} Sim_Cell;
+
+typedef struct {
+    double i, v, ocv;
+    bool voltage_mode; // Charger is holding the voltage limit
+} Sim_Drive;
+
+typedef struct {
+    ChargeState_t final_state;
+    uint32_t end_ms, cv_ms;    // Simulated time at the end / on entering CV
+    double peak_temp, final_soc;
+    uint64_t controller_calls;
+} Sim_Result;
+
+static inline int Sim_OcvSegment(double soc) {
+    int seg = 0;
+    while (seg < SIM_OCV_POINTS - 2 && soc >= sim_ocv_soc[seg + 1]) seg++;
+    return seg;
+}
+
+// OCV = a + b * soc on one segment
+static inline void Sim_OcvLine(int seg, double *a, double *b) {
+    *b = (sim_ocv_v[seg + 1] - sim_ocv_v[seg]) / (sim_ocv_soc[seg + 1] - sim_ocv_soc[seg]);
+    *a = sim_ocv_v[seg] - *b * sim_ocv_soc[seg];
+}
+
+static inline double Sim_Ocv(double soc) {
+    double a, b;
+    Sim_OcvLine(Sim_OcvSegment(soc), &a, &b);
+    return a + b * soc;
+}
+
+static void Sim_Cell_SetCooling(Sim_Cell *c, double r_th, double c_th) {
+    c->r_th = r_th;
+    c->a_th = exp(-SIM_DT_S / (r_th * c_th));
+}
+
+void Sim_Cell_Init(Sim_Cell *c, const Sim_Scenario *s) {
+    c->soc = s->soc0;
+    c->v1 = c->v2 = 0.0;
+    c->temp = c->t_ambient = s->t_ambient;
+    c->r0 = s->r0;
+    c->a1 = exp(-SIM_DT_S / s->tau1);
+    c->b1 = s->r1 * (1.0 - c->a1);
+    c->a2 = exp(-SIM_DT_S / s->tau2);
+    c->b2 = s->r2 * (1.0 - c->a2);
+    c->k_soc = SIM_DT_S / (3600.0 * s->capacity_ah);
+    Sim_Cell_SetCooling(c, s->r_th, s->c_th);
+}
+
+// Charger response for the next step, from the present cell state
+static inline Sim_Drive Sim_Charger(const Sim_Cell *c, const ChargerCmd *cmd) {
+    Sim_Drive d;
+    d.ocv = Sim_Ocv(c->soc);
+    double v_rest = d.ocv + c->a1 * c->v1 + c->a2 * c->v2; // Terminal voltage at I = 0
+    double r_step = c->r0 + c->b1 + c->b2;
+    d.i = cmd->cmd_current_limit;
+    d.v = v_rest + d.i * r_step;
+    d.voltage_mode = cmd->cmd_voltage_limit > 0.0f && d.v > cmd->cmd_voltage_limit;
+    if (d.voltage_mode) {
+        d.i = (cmd->cmd_voltage_limit - v_rest) / r_step;
+        if (d.i < 0.0) {
+            d.i = 0.0;
+            d.v = v_rest;
+        } else {
+            d.v = cmd->cmd_voltage_limit; // Exactly the limit, as a real CV loop reports it
+        }
+    }
+    return d;
+}
+
+// One 1 ms plant step with the present command; writes the sensors for the next tick
+void Sim_Step(Sim_Cell *c, const ChargerCmd *cmd, Sensors *sens) {
+    Sim_Drive d = Sim_Charger(c, cmd);
+    c->v1 = c->a1 * c->v1 + c->b1 * d.i;
+    c->v2 = c->a2 * c->v2 + c->b2 * d.i;
+    c->soc += d.i * c->k_soc;
+    double t_eq = c->t_ambient + d.i * (d.v - d.ocv) * c->r_th;
+    c->temp = t_eq + (c->temp - t_eq) * c->a_th;
+    sens->voltage = (float)d.v;
+    sens->current = (float)d.i;
+    sens->temp_c = (float)c->temp;
+}
+
+// --- Fast-forward: skip steady stretches analytically ---
+// While the controller stays in one state its command is constant. If the
+// charger also stays in one mode (current or voltage limited) and the SOC stays
+// on one OCV segment, one step is an affine map of x = (soc, v1, v2, 1):
+//   current mode: I = i_cmd
+//   voltage mode: I = (v_lim - ocv_a - ocv_b * soc - a1 * v1 - a2 * v2) / r_step
+// so N steps are x_N = M^N x_0. M^(2^k) is built once per stretch by squaring,
+// and any N costs at most SIM_FF_LEVELS matrix-vector products. This is the
+// discrete-time solution, so the electrical state matches 1 ms stepping up to
+// rounding. The temperature uses the first-order closed form with the heat
+// averaged over the chunk, and the chunk is shortened until the heat changes
+// by less than SIM_FF_HEAT_TOL.
+// A chunk starts only on a tick without a transition (so 'cmd' is the state's
+// command) and is taken only if the controller would not leave its state on the
+// sensors of the chunk's last step (checked with charge_next[], the table form
+// of Controller_Run()). Within a chunk, voltage (CC, precharge), current (CV)
+// and temperature are monotone, so no step in between can fire a guard either.
+// The chunk also never crosses a scenario event (plug-in, cooling failure).
+#define SIM_FF_LEVELS   24     // Up to 2^24 ms (4.6 h) per chunk
+#define SIM_FF_MIN_MS   16     // Shorter stretches are stepped normally
+#define SIM_FF_HEAT_TOL 0.02
+
+typedef struct { double m[4][4]; } Sim_Affine;
+
+typedef struct {
+    int key;                            // (state, charger mode, OCV segment); -1 = none
+    Sim_Affine pow2[SIM_FF_LEVELS];     // M^(2^k)
+    uint32_t len;                       // Next chunk length to try
+} Sim_FastForward;
+
+static void Sim_Affine_Mul(const Sim_Affine *a, const Sim_Affine *b, Sim_Affine *out) {
+    for (int r = 0; r < 4; r++)
+        for (int col = 0; col < 4; col++) {
+            double acc = 0.0;
+            for (int k = 0; k < 4; k++) acc += a->m[r][k] * b->m[k][col];
+            out->m[r][col] = acc;
+        }
+}
+
+static void Sim_Affine_Apply(const Sim_Affine *a, double x[4]) {
+    double y[4];
+    for (int r = 0; r < 4; r++) y[r] = a->m[r][0] * x[0] + a->m[r][1] * x[1] + a->m[r][2] * x[2] + a->m[r][3] * x[3];
+    memcpy(x, y, sizeof(y));
+}
+
+static void Sim_FF_Build(Sim_FastForward *ff, const Sim_Cell *c, const ChargerCmd *cmd, bool voltage_mode, int seg) {
+    // Current as a linear function of x: I = g . x
+    double g[4] = { 0.0, 0.0, 0.0, cmd->cmd_current_limit };
+    if (voltage_mode) {
+        double ocv_a, ocv_b, r_step = c->r0 + c->b1 + c->b2;
+        Sim_OcvLine(seg, &ocv_a, &ocv_b);
+        g[0] = -ocv_b / r_step;
+        g[1] = -c->a1 / r_step;
+        g[2] = -c->a2 / r_step;
+        g[3] = (cmd->cmd_voltage_limit - ocv_a) / r_step;
+    }
+    Sim_Affine *m = &ff->pow2[0];
+    memset(m, 0, sizeof(*m));
+    for (int k = 0; k < 4; k++) {
+        m->m[0][k] = c->k_soc * g[k];
+        m->m[1][k] = c->b1 * g[k];
+        m->m[2][k] = c->b2 * g[k];
+    }
+    m->m[0][0] += 1.0;
+    m->m[1][1] += c->a1;
+    m->m[2][2] += c->a2;
+    m->m[3][3] = 1.0;
+    for (int k = 1; k < SIM_FF_LEVELS; k++) Sim_Affine_Mul(&ff->pow2[k - 1], &ff->pow2[k - 1], &ff->pow2[k]);
+}
+
+// Try to advance up to 'max_ms' ticks in one chunk. Returns the ticks skipped
+// (0: step normally); on success 'sens' holds the sensors of the last step.
+uint32_t Sim_FastForward_Try(Sim_FastForward *ff, Sim_Cell *c, ChargeState_t state, const ChargerCmd *cmd,
+                             Sensors *sens, uint32_t max_ms) {
+    if (max_ms < SIM_FF_MIN_MS) return 0;
+    Sim_Drive d0 = Sim_Charger(c, cmd);
+    int seg = Sim_OcvSegment(c->soc);
+    int key = ((int)state * 2 + d0.voltage_mode) * SIM_OCV_POINTS + seg;
+    if (key != ff->key) {
+        Sim_FF_Build(ff, c, cmd, d0.voltage_mode, seg);
+        ff->key = key;
+        ff->len = SIM_FF_MIN_MS;
+    }
+    double h0 = d0.i * (d0.v - d0.ocv);
+    uint32_t n = ff->len < max_ms ? ff->len : max_ms;
+    for (; n >= SIM_FF_MIN_MS; n /= 2) {
+        // Steps 1 .. n-1 analytically, then step n for real (exact sensors)
+        Sim_Cell t = *c;
+        double x[4] = { c->soc, c->v1, c->v2, 1.0 };
+        for (int k = 0; k < SIM_FF_LEVELS; k++)
+            if ((n - 1) >> k & 1) Sim_Affine_Apply(&ff->pow2[k], x);
+        t.soc = x[0];
+        t.v1 = x[1];
+        t.v2 = x[2];
+        if (Sim_OcvSegment(t.soc) != seg) continue;
+        Sim_Drive dn = Sim_Charger(&t, cmd);
+        double hn = dn.i * (dn.v - dn.ocv);
+        if (dn.voltage_mode != d0.voltage_mode || fabs(hn - h0) > SIM_FF_HEAT_TOL * fmax(fabs(h0), fabs(hn)) + 1e-6)
+            continue;
+        double t_eq = c->t_ambient + 0.5 * (h0 + hn) * c->r_th;
+        t.temp = t_eq + (c->temp - t_eq) * pow(c->a_th, (double)(n - 1));
+        Sensors s = *sens;
+        Sim_Step(&t, cmd, &s);
+        if (charge_next[state][Charge_Guards(s.voltage, s.current, s.temp_c, s.charger_connected)] != state) continue;
+        *c = t;
+        *sens = s;
+        ff->len = n < (1u << (SIM_FF_LEVELS - 1)) ? n * 2 : n;
+        return n;
+    }
+    ff->len = SIM_FF_MIN_MS;
+    return 0;
+}
+
+// One charge session. Ends on COMPLETE, on FAULT (after its one FAULT print) or
+// at the horizon. Needs Charge_Tables_Init() when fast-forwarding.
+Sim_Result Sim_Run(const Sim_Scenario *s, bool fast_forward) {
+    Sim_Cell cell;
+    Sim_Cell_Init(&cell, s);
+    ChargeController cc;
+    Controller_Init(&cc);
+    Sensors sens = { (float)Sim_Ocv(cell.soc), 0.0f, (float)cell.temp, 0 };
+    ChargerCmd cmd = { 0.0f, 0.0f };
+    Sim_FastForward ff;
+    ff.key = -1;
+    Sim_Result r = { STATE_IDLE, 0, UINT32_MAX, cell.temp, cell.soc, 0 };
+    bool cooling_failed = false;
+
+    uint32_t t = 0;
+    while (t < s->horizon_ms) {
+        sens.charger_connected = t >= s->connect_ms;
+        if (!cooling_failed && t >= s->cooling_fail_ms) {
+            Sim_Cell_SetCooling(&cell, 4.0 * s->r_th, s->c_th);
+            cooling_failed = true;
+        }
+        ChargeState_t before = cc.state;
+        Controller_Run(&cc, &sens, &cmd);
+        r.controller_calls++;
+        if (cc.state == STATE_CV && r.cv_ms == UINT32_MAX) r.cv_ms = t;
+        if (cc.state == STATE_COMPLETE || cc.state == STATE_FAULT) break;
+
+        uint32_t next_event = s->horizon_ms;
+        if (t < s->connect_ms && s->connect_ms < next_event) next_event = s->connect_ms;
+        if (!cooling_failed && s->cooling_fail_ms < next_event) next_event = s->cooling_fail_ms;
+        // On a transition tick 'cmd' still belongs to the old state: step it normally
+        uint32_t n = 0;
+        if (fast_forward && cc.state == before) n = Sim_FastForward_Try(&ff, &cell, cc.state, &cmd, &sens, next_event - t);
+        if (n == 0) {
+            Sim_Step(&cell, &cmd, &sens);
+            n = 1;
+        }
+        t += n;
+        if (cell.temp > r.peak_temp) r.peak_temp = cell.temp;
+    }
+    r.final_state = cc.state;
+    r.end_ms = t;
+    r.final_soc = cell.soc;
+    return r;
+}
+
+// Deterministic scenario mix for planning runs: pack sizes, aging (resistance),
+// ambient, cooling quality, deep-discharged packs (precharge) and cooling failures
+void Sim_Scenarios_Init(Sim_Scenario *s, size_t n, uint32_t seed) {
+    plant_seed = seed;
+    for (size_t k = 0; k < n; k++) {
+        Sim_Scenario *sc = &s[k];
+        sc->capacity_ah = Plant_Rand(2.0f, 20.0f);
+        sc->soc0 = Plant_Rand(-0.03f, 0.7f);
+        sc->r0 = Plant_Rand(0.03f, 0.06f) / sc->capacity_ah;
+        sc->r1 = 0.4 * sc->r0;
+        sc->tau1 = Plant_Rand(5.0f, 20.0f);
+        sc->r2 = 0.3 * sc->r0;
+        sc->tau2 = Plant_Rand(100.0f, 400.0f);
+        sc->r_th = Plant_Rand(4.0f, 12.0f);
+        sc->c_th = 40.0 * sc->capacity_ah;
+        sc->t_ambient = Plant_Rand(10.0f, 40.0f);
+        sc->connect_ms = (uint32_t)Plant_Rand(0.0f, 600000.0f);
+        sc->cooling_fail_ms = Plant_Rand(0.0f, 1.0f) < 0.15f ? (uint32_t)Plant_Rand(0.0f, 3600000.0f) : UINT32_MAX;
+        sc->horizon_ms = 10u * 3600u * 1000u;
+    }
+}
+
+// --- Parallel scenarios: sessions differ in length by 10x and more, so the
+// threads pull scenario indices from a shared counter instead of fixed ranges ---
+typedef struct {
+    const Sim_Scenario *scen;
+    Sim_Result *res;
+    size_t count;
+    size_t next; // Shared, atomic
+    bool fast_forward;
+} Sim_Batch;
+
+static void *Sim_Worker(void *arg) {
+    Sim_Batch *b = (Sim_Batch *)arg;
+    for (;;) {
+        size_t k = __atomic_fetch_add(&b->next, 1, __ATOMIC_RELAXED);
+        if (k >= b->count) break;
+        b->res[k] = Sim_Run(&b->scen[k], b->fast_forward);
+    }
+    return NULL;
+}
+
+// Returns the simulated hours
+double Sim_Run_Parallel(const Sim_Scenario *scen, Sim_Result *res, size_t count, bool fast_forward, int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > FLEET_MAX_THREADS) threads = FLEET_MAX_THREADS;
+    Sim_Batch batch = { scen, res, count, 0, fast_forward };
+    pthread_t tid[FLEET_MAX_THREADS];
+    bool started[FLEET_MAX_THREADS] = { false };
+    // A thread that cannot be created just leaves its share to the others
+    for (int t = 1; t < threads; t++) started[t] = pthread_create(&tid[t], NULL, Sim_Worker, &batch) == 0;
+    Sim_Worker(&batch);
+    for (int t = 1; t < threads; t++)
+        if (started[t]) pthread_join(tid[t], NULL);
+
+    double hours = 0.0;
+    for (size_t k = 0; k < count; k++) hours += res[k].end_ms / 3.6e6;
+    return hours;
+}
+
+// Controller_Run() prints on every FAULT call. The checks record that text
+// (Fsm_Print.h) and compare it; benchmarks and long runs discard it.
+static const char fault_line[] = "!! FAULT ACTIVE !!\n";
+
+// Number of FAULT lines in the log, or SIZE_MAX if it holds anything else
+static size_t Fault_Lines(const Fsm_Log *log) {
+    size_t n = sizeof(fault_line) - 1;
+    if (log->failed || log->len % n != 0) return SIZE_MAX;
+    for (size_t k = 0; k < log->len; k += n)
+        if (memcmp(log->buf + k, fault_line, n) != 0) return SIZE_MAX;
+    return log->len / n;
+}
+
+static double Bench_NowSec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
 int main() {
     ChargeController cc;
     Sensors sens = {2.5f, 0.0f, 25.0f, 0}; // Start: 2.5V, Room Temp, Disconnected
@@ -144,5 +860,305 @@ int main() {
     Controller_Run(&cc, &sens, &cmd);
     printf("State: %d (Expect 5-Fault)     | Cmd: %.1f A\n", cc.state, cmd.cmd_current_limit);
 
-    return 0;
+    printf("\n--- Batched Fleet Controller ---\n");
+    Controller_Batch_Init();
+    #define VERIFY_PACKS 4099 // Not a multiple of 8: exercises the tail
+    #define VERIFY_TICKS 3000
+    Charge_Fleet ref_fleet, batch_fleet;
+    Fleet_Plant ref_plant, batch_plant;
+    ChargeController *ref_cc = malloc(VERIFY_PACKS * sizeof(ChargeController));
+    if (!ref_cc || !Fleet_Init(&ref_fleet, VERIFY_PACKS) || !Fleet_Init(&batch_fleet, VERIFY_PACKS)) return 1;
+    plant_seed = 777;
+    if (!Fleet_Plant_Init(&ref_plant, VERIFY_PACKS, VERIFY_TICKS)) return 1;
+    plant_seed = 777;
+    if (!Fleet_Plant_Init(&batch_plant, VERIFY_PACKS, VERIFY_TICKS)) return 1;
+    for (size_t k = 0; k < VERIFY_PACKS; k++) Controller_Init(&ref_cc[k]);
+
+    size_t ref_faults = 0, batch_faults = 0, printed_faults = 0, mismatch_ticks = 0;
+    size_t visits[CHARGE_STATE_COUNT] = { 0 };
+    Fsm_Log ref_log = { 0 };
+    for (uint32_t tick = 0; tick < VERIFY_TICKS; tick++) {
+        // What Controller_Run() actually printed must match both counts
+        Fsm_Log_Clear(&ref_log);
+        fsm_print_log = &ref_log;
+        size_t ref_tick = Fleet_Run_Reference(ref_cc, &ref_fleet, 0, VERIFY_PACKS);
+        fsm_print_log = NULL;
+        size_t batch_tick = Controller_Run_Batch(&batch_fleet, 0, VERIFY_PACKS);
+        size_t printed_tick = Fault_Lines(&ref_log);
+        ref_faults += ref_tick;
+        batch_faults += batch_tick;
+        printed_faults += printed_tick == SIZE_MAX ? 0 : printed_tick;
+        bool same = memcmp(ref_fleet.cmd_current_limit, batch_fleet.cmd_current_limit, VERIFY_PACKS * sizeof(float)) == 0 &&
+                    memcmp(ref_fleet.cmd_voltage_limit, batch_fleet.cmd_voltage_limit, VERIFY_PACKS * sizeof(float)) == 0;
+        for (size_t k = 0; k < VERIFY_PACKS; k++) {
+            same = same && ref_cc[k].state == (ChargeState_t)batch_fleet.state[k];
+            visits[batch_fleet.state[k]]++;
+        }
+        same = same && printed_tick == ref_tick && batch_tick == ref_tick;
+        mismatch_ticks += !same;
+        Fleet_Plant_Step(&ref_plant, &ref_fleet, 0, VERIFY_PACKS, tick);
+        Fleet_Plant_Step(&batch_plant, &batch_fleet, 0, VERIFY_PACKS, tick);
+    }
+    Fsm_Log_Free(&ref_log);
+    printf("%d packs x %d ticks (%s): states, commands and FAULT lines %s (printed %zu, counted %zu vs %zu)\n",
+           VERIFY_PACKS, VERIFY_TICKS, fleet_batch_impl, mismatch_ticks ? "MISMATCH!" : "IDENTICAL", printed_faults,
+           ref_faults, batch_faults);
+    printf("Pack-ticks per state: IDLE %zu | PRE %zu | CC %zu | CV %zu | DONE %zu | FAULT %zu\n",
+           visits[0], visits[1], visits[2], visits[3], visits[4], visits[5]);
+
+    // Every state against threshold and NaN edge values, one step each
+    const float edge_v[6] = { NAN, 2.99f, V_PRECHARGE_EXIT, 4.19f, V_TARGET, INFINITY };
+    const float edge_i[3] = { NAN, 0.49f, I_TERMINATION };
+    const float edge_t[3] = { NAN, TEMP_MAX, 45.01f };
+    const int32_t edge_c[4] = { 0, 1, -1, 2 }; // 6 * 6 * 3 * 3 * 4 cases: whole 8-lane blocks
+    size_t edge_cases = 0, edge_bad = 0;
+    fsm_print_log = &fsm_log_discard;
+    for (int st = 0; st < CHARGE_STATE_COUNT; st++)
+        for (int a = 0; a < 6; a++)
+            for (int b = 0; b < 3; b++)
+                for (int c = 0; c < 3; c++)
+                    for (int d = 0; d < 4; d++) {
+                        size_t k = edge_cases++ % 8; // Lanes 0..7: one AVX2 block
+                        ref_cc[k].state = (ChargeState_t)st;
+                        batch_fleet.state[k] = (uint8_t)st;
+                        ref_fleet.voltage[k] = batch_fleet.voltage[k] = edge_v[a];
+                        ref_fleet.current[k] = batch_fleet.current[k] = edge_i[b];
+                        ref_fleet.temp_c[k] = batch_fleet.temp_c[k] = edge_t[c];
+                        ref_fleet.charger_connected[k] = batch_fleet.charger_connected[k] = edge_c[d];
+                        if (k < 7) continue;
+                        Fleet_Run_Reference(ref_cc, &ref_fleet, 0, 8);
+                        Controller_Run_Batch(&batch_fleet, 0, 8);
+                        for (size_t l = 0; l < 8; l++)
+                            edge_bad += ref_cc[l].state != (ChargeState_t)batch_fleet.state[l] ||
+                                        ref_fleet.cmd_current_limit[l] != batch_fleet.cmd_current_limit[l] ||
+                                        ref_fleet.cmd_voltage_limit[l] != batch_fleet.cmd_voltage_limit[l];
+                    }
+    fsm_print_log = NULL;
+    printf("Edge values (NaN, thresholds, +inf, connected = -1): %zu cases, %s\n", edge_cases,
+           edge_bad ? "MISMATCH!" : "IDENTICAL");
+
+    Fleet_Free(&ref_fleet);
+    Fleet_Free(&batch_fleet);
+    Fleet_Plant_Free(&ref_plant);
+    Fleet_Plant_Free(&batch_plant);
+    free(ref_cc);
+
+    // Partitioned mode against one partition: odd fleet sizes, including ones
+    // where n / threads is a multiple of 64 but n is not divisible by threads
+    const size_t part_sizes[3] = { 10241, 4099, 130 };
+    size_t part_bad = 0, part_runs = 0;
+    for (int s = 0; s < 3; s++) {
+        size_t n = part_sizes[s];
+        Charge_Fleet serial, parallel;
+        Fleet_Plant serial_plant, parallel_plant;
+        plant_seed = 31337;
+        if (!Fleet_Init(&serial, n) || !Fleet_Plant_Init(&serial_plant, n, 1000)) return 1;
+        size_t serial_faults = Fleet_Run_Parallel(&serial, &serial_plant, 1000, 1);
+        for (int threads = 2; threads <= 4; threads++) {
+            plant_seed = 31337;
+            if (!Fleet_Init(&parallel, n) || !Fleet_Plant_Init(&parallel_plant, n, 1000)) return 1;
+            size_t parallel_faults = Fleet_Run_Parallel(&parallel, &parallel_plant, 1000, threads);
+            part_bad += parallel_faults != serial_faults || memcmp(serial.state, parallel.state, n) != 0 ||
+                        memcmp(serial.cmd_current_limit, parallel.cmd_current_limit, n * sizeof(float)) != 0 ||
+                        memcmp(serial.voltage, parallel.voltage, n * sizeof(float)) != 0;
+            part_runs++;
+            Fleet_Free(&parallel);
+            Fleet_Plant_Free(&parallel_plant);
+        }
+        Fleet_Free(&serial);
+        Fleet_Plant_Free(&serial_plant);
+    }
+    printf("Partitioned (2-4 threads) vs 1 partition, %zu runs of 10241/4099/130 packs x 1000 ticks: %s\n",
+           part_runs, part_bad ? "MISMATCH!" : "IDENTICAL");
+
+    // Benchmark: controller time only (the plant step is not timed)
+    #define BENCH_PACKS 10240
+    #define BENCH_TICKS 2000
+    const char *bench_names[3] = { "Controller_Run per pack", "Batch (tables, scalar)", "Batch (tables, best)" };
+    for (int mode = 0; mode < 3; mode++) {
+        Charge_Fleet fleet;
+        Fleet_Plant plant;
+        ChargeController *cc = malloc(BENCH_PACKS * sizeof(ChargeController));
+        plant_seed = 4242;
+        if (!cc || !Fleet_Init(&fleet, BENCH_PACKS) || !Fleet_Plant_Init(&plant, BENCH_PACKS, BENCH_TICKS)) return 1;
+        for (size_t k = 0; k < BENCH_PACKS; k++) Controller_Init(&cc[k]);
+        double t_ctrl = 0.0;
+        fsm_print_log = &fsm_log_discard;
+        for (uint32_t tick = 0; tick < BENCH_TICKS; tick++) {
+            double t0 = Bench_NowSec();
+            if (mode == 0) Fleet_Run_Reference(cc, &fleet, 0, BENCH_PACKS);
+            else if (mode == 1) Controller_Run_Batch_Scalar(&fleet, 0, BENCH_PACKS);
+            else Controller_Run_Batch(&fleet, 0, BENCH_PACKS);
+            t_ctrl += Bench_NowSec() - t0;
+            Fleet_Plant_Step(&plant, &fleet, 0, BENCH_PACKS, tick);
+        }
+        fsm_print_log = NULL;
+        printf("%-26s %8.1f M pack-steps/s\n", bench_names[mode], (double)BENCH_PACKS * BENCH_TICKS / t_ctrl * 1e-6);
+        Fleet_Free(&fleet);
+        Fleet_Plant_Free(&plant);
+        free(cc);
+    }
+
+    // Partitioned threads: plant + batch controller, whole run per thread
+    for (int threads = 1; threads <= 4; threads *= 2) {
+        Charge_Fleet fleet;
+        Fleet_Plant plant;
+        plant_seed = 4242;
+        if (!Fleet_Init(&fleet, BENCH_PACKS) || !Fleet_Plant_Init(&plant, BENCH_PACKS, BENCH_TICKS)) return 1;
+        double t0 = Bench_NowSec();
+        size_t faults = Fleet_Run_Parallel(&fleet, &plant, BENCH_TICKS, threads);
+        double dt = Bench_NowSec() - t0;
+        printf("%d thread(s), plant + controller: %8.1f M pack-steps/s (FAULT pack-steps %zu)\n", threads,
+               (double)BENCH_PACKS * BENCH_TICKS / dt * 1e-6, faults);
+        Fleet_Free(&fleet);
+        Fleet_Plant_Free(&plant);
+    }
+
+    // Generated FSM vs hand-written switch: random sensor frames, 64 controllers.
+    // COMPLETE and FAULT are dead ends, so a controller that reaches one restarts
+    // in IDLE (the same way for every implementation).
+    printf("\n--- Generated FSM (Fsm_Gen.h) vs Controller_Run ---\n");
+    #define GEN_FRAMES 4096
+    #define GEN_CTRL 64
+    #define GEN_STEPS 200000
+    static Sensors frames[GEN_FRAMES];
+    plant_seed = 99;
+    for (int k = 0; k < GEN_FRAMES; k++)
+        frames[k] = (Sensors){ Plant_Rand(2.5f, 4.5f), Plant_Rand(0.0f, 1.0f),
+                               Plant_Rand(0.0f, 1.0f) < 0.002f ? 50.0f : 25.0f, Plant_Rand(0.0f, 1.0f) < 0.5f };
+    const char *gen_names[3] = { "Controller_Run (hand)", "Charger_Step_Switch", "Charger_Step_Table" };
+    uint8_t gen_trace[3][GEN_CTRL];
+    float gen_cmd_trace[3][GEN_CTRL];
+    double gen_rate[3];
+    uint64_t gen_transitions[3];
+    Fsm_Log gen_log[3] = { { 0 } }; // Everything each implementation printed
+    bool gen_same = true;
+    for (int impl = 0; impl < 3; impl++) {
+        ChargeController hand[GEN_CTRL];
+        Charger_Fsm gen[GEN_CTRL];
+        ChargerCmd cmds[GEN_CTRL] = { { 0 } };
+        uint64_t transitions = 0, hash = 0;
+        for (int c = 0; c < GEN_CTRL; c++) {
+            Controller_Init(&hand[c]);
+            Charger_Io io = { NULL, &cmds[c] };
+            Charger_Init(&gen[c], &io);
+        }
+        fsm_print_log = &gen_log[impl];
+        double t0 = Bench_NowSec();
+        for (int step = 0; step < GEN_STEPS; step++) {
+            for (int c = 0; c < GEN_CTRL; c++) {
+                Sensors *sens = &frames[(step + c * 61) & (GEN_FRAMES - 1)];
+                int before, after;
+                if (impl == 0) {
+                    before = hand[c].state;
+                    Controller_Run(&hand[c], sens, &cmds[c]);
+                    after = hand[c].state;
+                    if (after == STATE_COMPLETE || after == STATE_FAULT) hand[c].state = STATE_IDLE;
+                } else {
+                    Charger_Io io = { sens, &cmds[c] };
+                    before = gen[c].state;
+                    if (impl == 1) Charger_Step_Switch(&gen[c], &io, CHG_EV_TICK);
+                    else Charger_Step_Table(&gen[c], &io, CHG_EV_TICK);
+                    after = gen[c].state;
+                    if (after == CHG_COMPLETE || after == CHG_FAULT) gen[c].state = CHG_IDLE;
+                }
+                transitions += (before != after);
+                hash = hash * 31 + (uint64_t)after;
+            }
+        }
+        double dt = Bench_NowSec() - t0;
+        fsm_print_log = NULL;
+        gen_rate[impl] = (double)transitions / dt;
+        gen_transitions[impl] = transitions ^ hash;
+        for (int c = 0; c < GEN_CTRL; c++) {
+            gen_trace[impl][c] = (uint8_t)(impl == 0 ? (int)hand[c].state : (int)gen[c].state);
+            gen_cmd_trace[impl][c] = cmds[c].cmd_current_limit + cmds[c].cmd_voltage_limit;
+        }
+        if (impl > 0)
+            gen_same = gen_same && gen_transitions[impl] == gen_transitions[0] &&
+                       memcmp(gen_trace[impl], gen_trace[0], sizeof(gen_trace[0])) == 0 &&
+                       memcmp(gen_cmd_trace[impl], gen_cmd_trace[0], sizeof(gen_cmd_trace[0])) == 0 &&
+                       !gen_log[impl].failed && Fsm_Log_Equal(&gen_log[impl], &gen_log[0]);
+        printf("%-22s %7.1f M transitions/s (%.1f M steps/s)\n", gen_names[impl], gen_rate[impl] * 1e-6,
+               (double)GEN_STEPS * GEN_CTRL / dt * 1e-6);
+    }
+    gen_same = gen_same && Fault_Lines(&gen_log[0]) != SIZE_MAX;
+    printf("State sequence of every step (hash), final states, commands and output (%zu FAULT lines): %s\n",
+           Fsm_Log_Lines(&gen_log[0]), gen_same ? "IDENTICAL" : "MISMATCH!");
+    for (int impl = 0; impl < 3; impl++) Fsm_Log_Free(&gen_log[impl]);
+    printf("Faster generated dispatch here: %s\n", gen_rate[1] >= gen_rate[2] ? "switch" : "jump table");
+
+    // Charging profile simulator: whole sessions at 1 ms, stepped vs fast-forward
+    printf("\n--- Charging Profile Simulator (2RC cell + thermal, 1 ms steps) ---\n");
+    #define SIM_VERIFY 48
+    #define SIM_BENCH  2048
+    Sim_Scenario *scen = malloc(SIM_BENCH * sizeof(Sim_Scenario));
+    Sim_Result *res_step = malloc(SIM_VERIFY * sizeof(Sim_Result));
+    Sim_Result *res_ff = malloc(SIM_BENCH * sizeof(Sim_Result));
+    if (!scen || !res_step || !res_ff) return 1;
+    Sim_Scenarios_Init(scen, SIM_BENCH, 2024);
+
+    fsm_print_log = &fsm_log_discard; // Each faulted session prints its FAULT line once
+    double t0 = Bench_NowSec();
+    double hours_step = Sim_Run_Parallel(scen, res_step, SIM_VERIFY, false, 1);
+    double wall_step = Bench_NowSec() - t0;
+    t0 = Bench_NowSec();
+    double hours_ff = Sim_Run_Parallel(scen, res_ff, SIM_VERIFY, true, 1);
+    double wall_ff = Bench_NowSec() - t0;
+    fsm_print_log = NULL;
+
+    // Differences per outcome of the 1 ms run: COMPLETE depends only on the
+    // exact electrical state, FAULT also on the averaged-heat temperature
+    size_t outcome[CHARGE_STATE_COUNT] = { 0 }, state_bad = 0;
+    uint64_t calls_step = 0, calls_ff = 0;
+    uint32_t end_diff[CHARGE_STATE_COUNT] = { 0 }, cv_diff = 0;
+    double peak_diff[CHARGE_STATE_COUNT] = { 0.0 }, soc_diff[CHARGE_STATE_COUNT] = { 0.0 };
+    for (size_t k = 0; k < SIM_VERIFY; k++) {
+        const Sim_Result *a = &res_step[k], *b = &res_ff[k];
+        ChargeState_t o = a->final_state;
+        outcome[o]++;
+        state_bad += a->final_state != b->final_state || (a->cv_ms == UINT32_MAX) != (b->cv_ms == UINT32_MAX);
+        uint32_t d = a->end_ms > b->end_ms ? a->end_ms - b->end_ms : b->end_ms - a->end_ms;
+        if (d > end_diff[o]) end_diff[o] = d;
+        if (a->cv_ms != UINT32_MAX && b->cv_ms != UINT32_MAX) {
+            d = a->cv_ms > b->cv_ms ? a->cv_ms - b->cv_ms : b->cv_ms - a->cv_ms;
+            if (d > cv_diff) cv_diff = d;
+        }
+        peak_diff[o] = fmax(peak_diff[o], fabs(a->peak_temp - b->peak_temp));
+        soc_diff[o] = fmax(soc_diff[o], fabs(a->final_soc - b->final_soc));
+        calls_step += a->controller_calls;
+        calls_ff += b->controller_calls;
+    }
+    printf("%d sessions: COMPLETE %zu | FAULT %zu | still charging at 10 h %zu\n", SIM_VERIFY,
+           outcome[STATE_COMPLETE], outcome[STATE_FAULT], SIM_VERIFY - outcome[STATE_COMPLETE] - outcome[STATE_FAULT]);
+    printf("1 ms stepping: %7.1f sim-h in %6.3f s -> %10.1f sim-h/wall-s (%llu controller calls)\n",
+           hours_step, wall_step, hours_step / wall_step, (unsigned long long)calls_step);
+    printf("Fast-forward:  %7.1f sim-h in %6.3f s -> %10.1f sim-h/wall-s (%llu controller calls)\n",
+           hours_ff, wall_ff, hours_ff / wall_ff, (unsigned long long)calls_ff);
+    printf("Fast-forward vs stepping: final states %s, max |dt| CV entry %u ms\n",
+           state_bad ? "MISMATCH!" : "IDENTICAL", cv_diff);
+    const ChargeState_t sim_outcomes[2] = { STATE_COMPLETE, STATE_FAULT };
+    for (int o = 0; o < 2; o++) {
+        ChargeState_t st = sim_outcomes[o];
+        printf("  %-8s sessions (%2zu): max |dt| end %u ms, max |d peak temp| %.4f K, max |d SOC| %.2e\n",
+               st == STATE_COMPLETE ? "COMPLETE" : "FAULT", outcome[st], end_diff[st], peak_diff[st], soc_diff[st]);
+    }
+
+    // Throughput: many independent sessions across threads (fast-forward)
+    for (int threads = 1; threads <= 4; threads *= 2) {
+        fsm_print_log = &fsm_log_discard; // Worker threads: discarding is the only thread-safe log
+        t0 = Bench_NowSec();
+        double hours = Sim_Run_Parallel(scen, res_ff, SIM_BENCH, true, threads);
+        double wall = Bench_NowSec() - t0;
+        fsm_print_log = NULL;
+        size_t faults = 0;
+        for (size_t k = 0; k < SIM_BENCH; k++) faults += res_ff[k].final_state == STATE_FAULT;
+        printf("%d thread(s): %d sessions (%zu FAULT), %7.1f sim-h in %6.3f s -> %8.1f sim-h/wall-s\n", threads,
+               SIM_BENCH, faults, hours, wall, hours / wall);
+    }
+    free(scen);
+    free(res_step);
+    free(res_ff);
+
+    return (mismatch_ticks == 0 && edge_bad == 0 && part_bad == 0 && gen_same) ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+// Declarative State Machine Generator (Header-Only, X-Macros)
+// Describe an FSM once as data, then include this header to generate the code:
+//
+//   #define FSM_NAME        Charger                   // Prefix of every generated name
+//   #define FSM_CTX         Charger_Io                // User context type, 'ctx' in expressions
+//   #define FSM_INITIAL     CHG_IDLE
+//   #define FSM_DISPATCH    FSM_DISPATCH_SWITCH       // or FSM_DISPATCH_TABLE
+//   #define FSM_STATES(S)   S(CHG_IDLE, FSM_NORMAL, entry, during, exit) ...
+//   #define FSM_EVENTS(E)   E(CHG_EV_TICK) ...
+//   #define FSM_TRANSITIONS(T) T(from, event, guard, action, to) ...
+//   #include "../FSM_Generator/Fsm_Gen.h"
+//
+// entry / during / exit / action are expressions (FSM_NONE for nothing) and
+// guard is a condition (FSM_ALWAYS for none). 'fsm' (the instance) and 'ctx'
+// are in scope. Wrap any top-level comma in parentheses. from may be FSM_ANY,
+// event may be FSM_EV_ANY.
+//
+// One step (Name_Step(fsm, ctx, event)) does:
+//   1. FSM_ANY transitions, in listed order (the first match fires; a state
+//      never re-enters itself through FSM_ANY). Example: over-temperature -> FAULT.
+//   2. The current state's 'during' action.
+//   3. The current state's transitions, in listed order (the first match fires).
+// Firing runs exit(from), action, state = to, the transition hook, entry(to).
+//
+// Generated per FSM (Name = FSM_NAME):
+//   - Name_State (enum of the state names, plus Name_STATE_COUNT), Name_Event,
+//     Name_Fsm, Name_state_names[], Name_Init()
+//   - Name_Step_Switch(): one switch over the states, with every body inlined
+//   - Name_Step_Table():  a dense jump table of per-state body functions
+//   - Name_Step(): whichever FSM_DISPATCH selects (profile both and pick one)
+// Compile-time checks (_Static_assert):
+//   - Every state is reachable from FSM_INITIAL through the transition graph.
+//   - A state without outgoing transitions must be marked FSM_TERMINAL, and an
+//     FSM_TERMINAL state must not have any (FSM_ANY transitions do not count).
+// Instrumentation:
+//   - FSM_TRANSITION_HOOK(from, to) runs on every transition. Define it before
+//     the include to trace or log. FSM_NAME is still defined inside it.
+//   - With -DFSM_COUNT_TRANSITIONS, Name_transition_count[from][to] counts them.
+//
+// The header can be included again for the next FSM; it #undefs its inputs.
+
+#ifndef FSM_GEN_CORE_H
+#define FSM_GEN_CORE_H
+
+#define FSM_MAX_STATES      16 // Reachability runs FSM_MAX_STATES - 1 propagation steps
+#define FSM_ANY             (-1)
+#define FSM_EV_ANY          (-1)
+#define FSM_NORMAL          0
+#define FSM_TERMINAL        1  // No outgoing transitions on purpose (latched or final)
+#define FSM_NONE            ((void)0)
+#define FSM_ALWAYS          1
+#define FSM_DISPATCH_SWITCH 0
+#define FSM_DISPATCH_TABLE  1
+
+#ifndef FSM_TRANSITION_HOOK
+#define FSM_TRANSITION_HOOK(from, to) ((void)0)
+#endif
+
+#define FSM_CAT_(a, b) a##b
+#define FSM_CAT(a, b)  FSM_CAT_(a, b)
+#define FSM_FN(suffix) FSM_CAT(FSM_NAME, suffix)
+
+#if defined(FSM_COUNT_TRANSITIONS)
+#define FSM_GEN_COUNT(from, to) (FSM_FN(_transition_count)[from][to]++)
+#else
+#define FSM_GEN_COUNT(from, to) ((void)0)
+#endif
+
+// --- Callbacks for the description lists. They refer to FSM_NAME / FSM_CTX
+// lazily, so they work for whichever FSM is being generated ---
+#define FSM_GEN_STATE_ENUM(st, flags, entry, during, exit) st,
+#define FSM_GEN_STATE_NAME(st, flags, entry, during, exit) #st,
+#define FSM_GEN_EVENT_ENUM(ev) ev,
+#define FSM_GEN_ENTER_CASE(st, flags, entry, during, exit) case st: entry; break;
+#define FSM_GEN_EXIT_CASE(st, flags, entry, during, exit)  case st: exit; break;
+
+#define FSM_GEN_FIRE(from, action, to)              \
+    do {                                            \
+        const int fsm_from = (from);                \
+        FSM_FN(_Exit)(fsm, ctx, fsm_from);          \
+        action;                                     \
+        fsm->state = (to);                          \
+        FSM_TRANSITION_HOOK(fsm_from, to);          \
+        FSM_GEN_COUNT(fsm_from, to);                \
+        FSM_FN(_Enter)(fsm, ctx, to);               \
+    } while (0)
+
+#define FSM_GEN_EVENT_MATCH(event) ((event) == FSM_EV_ANY || (event) == ev)
+
+// Priority transitions: only the FSM_ANY rows survive constant folding
+#define FSM_GEN_TRY_ANY(from, event, guard, action, to)                                  \
+    if ((from) == FSM_ANY && fsm->state != (to) && FSM_GEN_EVENT_MATCH(event) && (guard)) { \
+        FSM_GEN_FIRE(fsm->state, action, to);                                           \
+        return;                                                                         \
+    }
+
+// Inside a state body 'fsm_self' is a constant, so only that state's rows remain
+#define FSM_GEN_TRY(from, event, guard, action, to)                                      \
+    if ((from) == fsm_self && FSM_GEN_EVENT_MATCH(event) && (guard)) {                   \
+        FSM_GEN_FIRE(fsm_self, action, to);                                             \
+        return;                                                                         \
+    }
+
+#define FSM_GEN_BODY(st, flags, entry, during, exit)                                     \
+    static inline void FSM_CAT(st, _Body)(FSM_FN(_Fsm) *fsm, FSM_CTX *ctx, int ev) {     \
+        const int fsm_self = st;                                                         \
+        (void)fsm; (void)ctx; (void)ev; (void)fsm_self;                                  \
+        during;                                                                          \
+        FSM_TRANSITIONS(FSM_GEN_TRY)                                                     \
+    }
+
+#define FSM_GEN_CASE(st, flags, entry, during, exit) case st: FSM_CAT(st, _Body)(fsm, ctx, ev); break;
+#define FSM_GEN_TABLE_ENTRY(st, flags, entry, during, exit) [st] = FSM_CAT(st, _Body),
+
+// --- Static checks: bit masks over the state indices ---
+#define FSM_GEN_BIT(st) (1 << ((st) & 31))
+#define FSM_GEN_REACH_STEP(from, event, guard, action, to) \
+    | (((from) == FSM_ANY || (FSM_REACH_PREV & FSM_GEN_BIT(from))) ? FSM_GEN_BIT(to) : 0)
+#define FSM_GEN_OUT_BIT(from, event, guard, action, to) | ((from) == FSM_ANY ? 0 : FSM_GEN_BIT(from))
+#define FSM_GEN_CHECK_STATE(st, flags, entry, during, exit)                                    \
+    _Static_assert(FSM_FN(_reachable) & FSM_GEN_BIT(st), "FSM state " #st " is unreachable"); \
+    _Static_assert(!(FSM_FN(_has_out) & FSM_GEN_BIT(st)) == !!((flags) & FSM_TERMINAL),        \
+                   "FSM state " #st ": no outgoing transition (mark it FSM_TERMINAL) or FSM_TERMINAL with transitions");
+
+#endif // FSM_GEN_CORE_H
+
+// ============================================================================
+// Template part: runs once per include, for the FSM described by the inputs
+// ============================================================================
+#if !defined(FSM_NAME) || !defined(FSM_CTX) || !defined(FSM_INITIAL) || !defined(FSM_STATES) || \
+    !defined(FSM_EVENTS) || !defined(FSM_TRANSITIONS)
+#error "Fsm_Gen.h: define FSM_NAME, FSM_CTX, FSM_INITIAL, FSM_STATES, FSM_EVENTS and FSM_TRANSITIONS first"
+#endif
+#ifndef FSM_DISPATCH
+#define FSM_DISPATCH FSM_DISPATCH_SWITCH
+#endif
+
+typedef enum { FSM_STATES(FSM_GEN_STATE_ENUM) FSM_FN(_STATE_COUNT) } FSM_FN(_State);
+typedef enum { FSM_EVENTS(FSM_GEN_EVENT_ENUM) FSM_FN(_EVENT_COUNT) } FSM_FN(_Event);
+typedef struct { FSM_FN(_State) state; } FSM_FN(_Fsm);
+
+static const char *const FSM_FN(_state_names)[] = { FSM_STATES(FSM_GEN_STATE_NAME) };
+
+_Static_assert(FSM_FN(_STATE_COUNT) <= FSM_MAX_STATES, "FSM has more than FSM_MAX_STATES states");
+
+// Reachability: propagate from FSM_INITIAL along the transitions, one step per enum
+enum { FSM_FN(_reach0) = FSM_GEN_BIT(FSM_INITIAL) };
+#define FSM_REACH_PREV FSM_FN(_reach0)
+enum { FSM_FN(_reach1) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach1)
+enum { FSM_FN(_reach2) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach2)
+enum { FSM_FN(_reach3) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach3)
+enum { FSM_FN(_reach4) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach4)
+enum { FSM_FN(_reach5) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach5)
+enum { FSM_FN(_reach6) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach6)
+enum { FSM_FN(_reach7) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach7)
+enum { FSM_FN(_reach8) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach8)
+enum { FSM_FN(_reach9) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach9)
+enum { FSM_FN(_reach10) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach10)
+enum { FSM_FN(_reach11) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach11)
+enum { FSM_FN(_reach12) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach12)
+enum { FSM_FN(_reach13) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach13)
+enum { FSM_FN(_reach14) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+#define FSM_REACH_PREV FSM_FN(_reach14)
+enum { FSM_FN(_reachable) = FSM_REACH_PREV FSM_TRANSITIONS(FSM_GEN_REACH_STEP) };
+#undef FSM_REACH_PREV
+
+enum { FSM_FN(_has_out) = 0 FSM_TRANSITIONS(FSM_GEN_OUT_BIT) };
+FSM_STATES(FSM_GEN_CHECK_STATE)
+
+#if defined(FSM_COUNT_TRANSITIONS)
+static uint32_t FSM_FN(_transition_count)[FSM_FN(_STATE_COUNT)][FSM_FN(_STATE_COUNT)];
+#endif
+
+static inline void FSM_FN(_Enter)(FSM_FN(_Fsm) *fsm, FSM_CTX *ctx, int s) {
+    (void)fsm; (void)ctx;
+    switch (s) { FSM_STATES(FSM_GEN_ENTER_CASE) default: break; }
+}
+
+static inline void FSM_FN(_Exit)(FSM_FN(_Fsm) *fsm, FSM_CTX *ctx, int s) {
+    (void)fsm; (void)ctx;
+    switch (s) { FSM_STATES(FSM_GEN_EXIT_CASE) default: break; }
+}
+
+static inline void FSM_FN(_Init)(FSM_FN(_Fsm) *fsm, FSM_CTX *ctx) {
+    fsm->state = FSM_INITIAL;
+    FSM_FN(_Enter)(fsm, ctx, FSM_INITIAL);
+}
+
+static inline void FSM_FN(_Pre)(FSM_FN(_Fsm) *fsm, FSM_CTX *ctx, int ev) {
+    (void)fsm; (void)ctx; (void)ev;
+    FSM_TRANSITIONS(FSM_GEN_TRY_ANY)
+}
+
+FSM_STATES(FSM_GEN_BODY)
+
+static inline void FSM_FN(_Step_Switch)(FSM_FN(_Fsm) *fsm, FSM_CTX *ctx, int ev) {
+    FSM_FN(_Pre)(fsm, ctx, ev);
+    switch (fsm->state) {
+        FSM_STATES(FSM_GEN_CASE)
+        default: break;
+    }
+}
+
+static inline void FSM_FN(_Step_Table)(FSM_FN(_Fsm) *fsm, FSM_CTX *ctx, int ev) {
+    static void (*const table[FSM_FN(_STATE_COUNT)])(FSM_FN(_Fsm) *, FSM_CTX *, int) = {
+        FSM_STATES(FSM_GEN_TABLE_ENTRY)
+    };
+    FSM_FN(_Pre)(fsm, ctx, ev);
+    if ((unsigned)fsm->state < FSM_FN(_STATE_COUNT)) table[fsm->state](fsm, ctx, ev);
+}
+
+static inline void FSM_FN(_Step)(FSM_FN(_Fsm) *fsm, FSM_CTX *ctx, int ev) {
+#if FSM_DISPATCH == FSM_DISPATCH_TABLE
+    FSM_FN(_Step_Table)(fsm, ctx, ev);
+#else
+    FSM_FN(_Step_Switch)(fsm, ctx, ev);
+#endif
+}
+
+#undef FSM_NAME
+#undef FSM_CTX
+#undef FSM_INITIAL
+#undef FSM_DISPATCH
+#undef FSM_STATES
+#undef FSM_EVENTS
+#undef FSM_TRANSITIONS
@@ -0,0 +1,89 @@
+// Action Output for Checked FSMs (Header-Only)
+// The hand-written FSMs and their generated twins print through Fsm_Printf()
+// instead of printf(). By default the text goes to stdout. A test can send it
+// to an Fsm_Log instead, one log per side, and memcmp the two logs. That checks
+// the entry/during actions, not just the states.
+//
+//   Fsm_Log hand = { 0 }, gen = { 0 };
+//   fsm_print_log = &hand;  Comm_Update(&sys);
+//   fsm_print_log = &gen;   Comm_Step(&fsm, &ctx, COMM_EV_TICK);
+//   fsm_print_log = NULL;   // Back to stdout
+//   same = !hand.failed && !gen.failed && Fsm_Log_Equal(&hand, &gen);
+//
+// fsm_print_log = &fsm_log_discard drops the text (benchmarks, long runs).
+// The discard log is never written, so it is safe with worker threads; a
+// recording log is not.
+
+#ifndef FSM_PRINT_H
+#define FSM_PRINT_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t cap;
+    bool discard; // Drop the text, touch nothing
+    bool failed;  // Out of memory or format error: the log is incomplete
+} Fsm_Log;
+
+static Fsm_Log *fsm_print_log; // NULL: stdout
+__attribute__((unused)) static Fsm_Log fsm_log_discard = { .discard = true };
+
+__attribute__((format(printf, 1, 2)))
+static void Fsm_Printf(const char *fmt, ...) {
+    Fsm_Log *log = fsm_print_log;
+    va_list ap;
+    va_start(ap, fmt);
+    if (!log) {
+        vprintf(fmt, ap);
+    } else if (!log->discard && !log->failed) {
+        va_list again;
+        va_copy(again, ap);
+        int n = vsnprintf(log->buf ? log->buf + log->len : NULL, log->cap - log->len, fmt, ap);
+        if (n >= 0 && log->len + (size_t)n >= log->cap) {
+            // Grow (room for the terminating '\0') and format again
+            size_t cap = log->cap ? log->cap : 4096;
+            while (cap <= log->len + (size_t)n) cap *= 2;
+            char *buf = realloc(log->buf, cap);
+            if (buf) {
+                log->buf = buf;
+                log->cap = cap;
+                vsnprintf(log->buf + log->len, log->cap - log->len, fmt, again);
+            } else {
+                n = -1;
+            }
+        }
+        va_end(again);
+        if (n < 0) log->failed = true;
+        else log->len += (size_t)n;
+    }
+    va_end(ap);
+}
+
+static inline void Fsm_Log_Clear(Fsm_Log *log) {
+    log->len = 0;
+    log->failed = false;
+}
+
+static inline bool Fsm_Log_Equal(const Fsm_Log *a, const Fsm_Log *b) {
+    return a->len == b->len && (a->len == 0 || memcmp(a->buf, b->buf, a->len) == 0);
+}
+
+// Number of '\n'-terminated lines
+static inline size_t Fsm_Log_Lines(const Fsm_Log *log) {
+    size_t lines = 0;
+    for (size_t k = 0; k < log->len; k++) lines += log->buf[k] == '\n';
+    return lines;
+}
+
+static inline void Fsm_Log_Free(Fsm_Log *log) {
+    free(log->buf);
+    *log = (Fsm_Log){ 0 };
+}
+
+#endif // FSM_PRINT_H